@@ -1,5 +1,4 @@
 #include "AlarmSystem.h"
-#include "../Sensors/Coordination/SensorCoordinator.h"
 #include <iostream>
 #include <chrono>
 #include <iomanip>
@@ -11,14 +10,19 @@ AlarmSystem::AlarmSystem(SensorDatabase& sensorDb) : database(sensorDb) {
 }
 
 bool AlarmSystem::checkAlarm() {
-    cout << "[ALARM] Checking system status..." << endl;
+    const ContactStateTable& contacts = database.getContactStates();
+    cout << "[ALARM] Checking perimeter (" << contacts.size() 
+         << " contact sensors)..." << endl;
     
-    // Query SensorCoordinator to detect movement
-    bool movementDetected = SensorCoordinator::isMovementDetected();
+    // Whole perimeter at once: one bit per contact sensor
+    vector<u_int32_t> newlyOpened = database.takeNewlyOpenedContacts();
     
-    if (movementDetected) {
+    if (contacts.anyOpen()) {
         cout << "[ALARM] *** MOVEMENT DETECTED - SECURITY ALERT ***" << endl;
-        dumpRGBCameras();
+        cout << "[ALARM] " << contacts.countOpen() << " of " << contacts.size()
+             << " contacts open, " << newlyOpened.size() 
+             << " opened since the last check" << endl;
+        dumpRGBCameras(newlyOpened);
         return true; // Suspicious activity detected
     } else {
         cout << "[ALARM] System secure - No movement detected" << endl;
@@ -26,8 +30,10 @@ bool AlarmSystem::checkAlarm() {
     }
 }
 
-void AlarmSystem::dumpRGBCameras() {
-    vector<RGBCamera*> rgbCameras = findRGBCameras();
+void AlarmSystem::dumpRGBCameras(const vector<u_int32_t>& newlyOpened) {
+    // Cameras removed during the capture stay valid until we are done
+    EpochReclaimer::Guard guard(database.getReclaimer());
+    SensorTypeRange<RGBCamera> rgbCameras = findRGBCameras();
     
     if (rgbCameras.empty()) {
         cout << "[ALARM] No RGB cameras available for security capture" << endl;
@@ -40,15 +46,24 @@ void AlarmSystem::dumpRGBCameras() {
     
     cout << "\n==================== SECURITY CAPTURE ====================" << endl;
     cout << "TIMESTAMP: " << put_time(localtime(&time_t), "%Y-%m-%d %H:%M:%S") << endl;
-    cout << "TRIGGER: Movement detected by Contact Sensor" << endl;
+    cout << "TRIGGER: Movement detected by Contact Sensor";
+    if (!newlyOpened.empty()) {
+        cout << " (newly opened:";
+        for (u_int32_t sensorId : newlyOpened) {
+            cout << " #" << sensorId;
+        }
+        cout << ")";
+    }
+    cout << endl;
     cout << "RGB CAMERAS (" << rgbCameras.size() << " found):" << endl;
     cout << "==========================================================" << endl;
     
     for (size_t i = 0; i < rgbCameras.size(); i++) {
         RGBCamera* camera = rgbCameras[i];
         
-        // Force new data capture
+        // Force new data capture (logged, committed with the next group)
         camera->collectData();
+        database.recordReading(camera);
         
         cout << "\n[CAMERA " << (i + 1) << "] ID: " << camera->getSensorId() << endl;
         cout << *camera << endl;
@@ -57,18 +72,6 @@ void AlarmSystem::dumpRGBCameras() {
     cout << "\n================== END SECURITY CAPTURE ==================" << endl;
 }
 
-vector<RGBCamera*> AlarmSystem::findRGBCameras() {
-    vector<RGBCamera*> rgbCameras;
-    vector<Sensor*> allSensors = database.getAllSensors();
-    
-    for (Sensor* sensor : allSensors) {
-        if (sensor->getType() == Sensor::RGB_CAMERA) {
-            RGBCamera* rgbCamera = dynamic_cast<RGBCamera*>(sensor);
-            if (rgbCamera) {
-                rgbCameras.push_back(rgbCamera);
-            }
-        }
-    }
-    
-    return rgbCameras;
+SensorTypeRange<RGBCamera> AlarmSystem::findRGBCameras() {
+    return database.getSensorsOfType<RGBCamera>();
 }
\ No newline at end of file
@@ -13,17 +13,18 @@ public:
     // Destructor
     ~AlarmSystem() = default;
 
-    // Single method - checks status and dumps cameras if activity detected
+    // Single method - checks every contact sensor and dumps cameras if any
+    // is open
     bool checkAlarm();
 
 private:
     SensorDatabase& database;
     
     // Internal method for RGB cameras dump
-    void dumpRGBCameras();
+    void dumpRGBCameras(const std::vector<u_int32_t>& newlyOpened);
     
-    // Finds all RGB cameras in the system
-    std::vector<RGBCamera*> findRGBCameras();
+    // Finds all RGB cameras in the system (per-type index, no full scan)
+    SensorTypeRange<RGBCamera> findRGBCameras();
 };
 
 #endif // ALARMSYSTEM_H
\ No newline at end of file
@@ -0,0 +1,357 @@
+#include <iostream>
+#include <cstring>
+#include "ColumnarSensorDatabase.h"
+#include "SensorFileView.h"
+#include "SensorFileFormat.h"
+#include "WriteAheadLog.h"
+#include "../Sensors/SensorFactory.h"
+
+using namespace std;
+
+// Out-of-line definitions for the ODR-used constants
+constexpr int32_t ColumnarSensorDatabase::NO_ROW;
+constexpr size_t ColumnarSensorDatabase::ID_SPACE;
+
+namespace {
+    // Cameras keep a whole frame, everything else a single value
+    bool hasFrame(u_int32_t type) {
+        return SensorFileFormat::valueCount(type) > 1;
+    }
+}
+
+// Constructor
+ColumnarSensorDatabase::ColumnarSensorDatabase(const char* inputFilename)
+    : rowIndex(ID_SPACE, NO_ROW), modified(false) {
+    setFilename(inputFilename);
+
+    // Changes logged by SensorDatabase are not replayed here, and our next
+    // save would drop them
+    if (WriteAheadLog::hasPendingChanges(this->filename)) {
+        throw runtime_error("'" + string(this->filename) + "' has logged "
+                            "changes: open it with SensorDatabase first");
+    }
+
+    loadFromFile(this->filename);
+    modified = false;
+    addPrimarySensors();
+}
+
+// Destructor
+ColumnarSensorDatabase::~ColumnarSensorDatabase() {
+    if (!modified) {
+        return; // Nothing to write back
+    }
+    try {
+        saveToFile(this->filename);
+    } catch (const exception& e) {
+        cerr << "Error: " << e.what() << endl;
+    }
+}
+
+// Records go straight from the file into the columns, no Sensor objects
+bool ColumnarSensorDatabase::loadFromFile(const char* filename) {
+    SensorFileView view;
+    if (!view.open(filename)) {
+        cerr << "Warning: Could not open file '"
+            << filename << "' for reading." << endl;
+        return false;
+    }
+
+    bool ownFile = strcmp(filename, this->filename) == 0;
+    for (const SensorRecord& record : view) {
+        if (SensorFactory::isTombstone(record)) {
+            continue;
+        }
+        if (!SensorFactory::isValidRecord(record)) {
+            break;
+        }
+        if (rowOf(record.sensorId) != NO_ROW) {
+            if (!ownFile) {
+                cerr << "Warning: Duplicate sensor with ID "
+                     << record.sensorId << " ignored" << endl;
+            }
+            continue;
+        }
+        appendRow(record.sensorId, record.sensorType, record.data);
+    }
+    return true;
+}
+
+/**
+ * @brief Write every row to a compact file
+ *
+ * @throws runtime_error if the file cannot be written
+ */
+bool ColumnarSensorDatabase::saveToFile(const char* filename) {
+    if (!SensorFileFormat::writeBuffer(filename, exportCompact())) {
+        throw runtime_error("Could not open file for writing.");
+    }
+    if (strcmp(filename, this->filename) == 0) {
+        modified = false;
+    }
+    return true;
+}
+
+// Drop every non-primary sensor and write the primary ones back
+bool ColumnarSensorDatabase::clearFile(const char* filename) {
+    for (size_t row = ids.size(); row-- > 0; ) {
+        if (!Sensor::isPrimarySensorId(ids[row])) {
+            eraseRow(row);
+        }
+    }
+    return saveToFile(filename);
+}
+
+bool ColumnarSensorDatabase::addSensor(const Sensor* sensor) {
+    if (!sensor) {
+        throw invalid_argument("Cannot add null sensor");
+    }
+
+    // Validate sensor ID range
+    if (sensor->getSensorId() < Sensor::MIN_SENSOR_ID ||
+        sensor->getSensorId() > Sensor::MAX_SENSOR_ID) {
+        throw invalid_argument("Sensor ID must be between " +
+                              to_string(Sensor::MIN_SENSOR_ID) + " and " +
+                              to_string(Sensor::MAX_SENSOR_ID));
+    }
+
+    if (rowOf(sensor->getSensorId()) != NO_ROW) {
+        return false; // Sensor already exists
+    }
+    appendRow(sensor->getSensorId(), sensor->getType(), sensor->getFullData());
+    return true;
+}
+
+// Copy the type and data of a sensor over its row
+bool ColumnarSensorDatabase::updateSensor(const Sensor* sensor) {
+    if (!sensor) {
+        throw invalid_argument("Cannot update null sensor");
+    }
+
+    int32_t row = rowOf(sensor->getSensorId());
+    if (row == NO_ROW) {
+        return false; // Sensor not found
+    }
+
+    if (types[row] != sensor->getType()) {
+        // Replaced by a sensor of another type: it may gain or lose a frame
+        eraseRow(row);
+        appendRow(sensor->getSensorId(), sensor->getType(),
+                  sensor->getFullData());
+        return true;
+    }
+    setRowData(row, sensor->getFullData());
+    return true;
+}
+
+/**
+ * @brief Remove a sensor's row
+ *
+ * @return true if removed, false if no sensor has that ID
+ * @throws runtime_error if the sensor is a primary sensor
+ */
+bool ColumnarSensorDatabase::removeSensor(u_int32_t sensorId) {
+    int32_t row = rowOf(sensorId);
+    if (row == NO_ROW) {
+        return false;
+    }
+    if (Sensor::isPrimarySensorId(sensorId)) {
+        throw runtime_error("Cannot remove primary sensor with ID " +
+                           to_string(sensorId));
+    }
+    eraseRow(row);
+    return true;
+}
+
+/**
+ * @brief Change the ID of a stored sensor
+ *
+ * @return true if the ID was changed, false if the new ID is already in use
+ * @throws invalid_argument if the new ID is out of range
+ * @throws runtime_error if the sensor is primary or not found
+ */
+bool ColumnarSensorDatabase::changeSensorId(u_int32_t sensorId,
+                                            u_int32_t newSensorId) {
+    if (newSensorId < Sensor::MIN_SENSOR_ID ||
+        newSensorId > Sensor::MAX_SENSOR_ID) {
+        throw invalid_argument("Sensor ID must be between " +
+                              to_string(Sensor::MIN_SENSOR_ID) + " and " +
+                              to_string(Sensor::MAX_SENSOR_ID));
+    }
+    if (Sensor::isPrimarySensorId(sensorId)) {
+        throw runtime_error("Cannot change ID of primary sensor " +
+                           to_string(sensorId));
+    }
+
+    int32_t row = rowOf(sensorId);
+    if (row == NO_ROW) {
+        throw runtime_error("Sensor not found in database");
+    }
+    if (rowOf(newSensorId) != NO_ROW) {
+        return false; // New ID already in use
+    }
+
+    rowIndex[sensorId - Sensor::MIN_SENSOR_ID] = NO_ROW;
+    rowIndex[newSensorId - Sensor::MIN_SENSOR_ID] = row;
+    ids[row] = newSensorId;
+    modified = true;
+    return true;
+}
+
+bool ColumnarSensorDatabase::containsSensor(u_int32_t sensorId) const {
+    return rowOf(sensorId) != NO_ROW;
+}
+
+Sensor* ColumnarSensorDatabase::materialize(u_int32_t sensorId) const {
+    int32_t row = rowOf(sensorId);
+    if (row == NO_ROW) {
+        return nullptr;
+    }
+
+    SensorRecord record;
+    memset(&record, 0, sizeof(record));
+    record.sensorId = ids[row];
+    record.sensorType = types[row];
+    if (frameSlots[row] == NO_ROW) {
+        record.data[0] = values[row];
+    } else {
+        memcpy(record.data, frameOf(row), sizeof(record.data));
+    }
+    return SensorFactory::recordToSensor(record);
+}
+
+const int* ColumnarSensorDatabase::frameOf(size_t row) const {
+    if (frameSlots[row] == NO_ROW) {
+        return nullptr;
+    }
+    return &frames[frameSlots[row] * Sensor::MAX_DATA_SIZE];
+}
+
+// Reads the type column only
+size_t ColumnarSensorDatabase::countSensorsOfType(Sensor::Type type) const {
+    size_t count = 0;
+    for (u_int8_t rowType : types) {
+        count += (rowType == type);
+    }
+    return count;
+}
+
+void ColumnarSensorDatabase::countByType(
+        size_t counts[Sensor::TYPE_COUNT]) const {
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        counts[type] = 0;
+    }
+    for (u_int8_t rowType : types) {
+        counts[rowType]++;
+    }
+}
+
+// Sensors of a type whose current reading exceeds 'threshold' (reads the
+// type and value columns only)
+size_t ColumnarSensorDatabase::countAbove(Sensor::Type type,
+                                          int threshold) const {
+    size_t count = 0;
+    for (size_t row = 0; row < ids.size(); row++) {
+        count += (types[row] == type && values[row] > threshold);
+    }
+    return count;
+}
+
+// Encode every row in the compact file format; frames are only read for
+// cameras
+vector<char> ColumnarSensorDatabase::exportCompact() const {
+    vector<char> buffer;
+    SensorFileFormat::encodeHeader(static_cast<u_int32_t>(ids.size()), buffer);
+    for (size_t row = 0; row < ids.size(); row++) {
+        const int* data = (frameSlots[row] == NO_ROW) ? &values[row]
+                                                      : frameOf(row);
+        SensorFileFormat::encodeValues(ids[row], types[row], data, buffer);
+    }
+    return buffer;
+}
+
+// Look up the row of a sensor ID in O(1)
+int32_t ColumnarSensorDatabase::rowOf(u_int32_t sensorId) const {
+    if (sensorId < Sensor::MIN_SENSOR_ID || sensorId > Sensor::MAX_SENSOR_ID) {
+        return NO_ROW;
+    }
+    return rowIndex[sensorId - Sensor::MIN_SENSOR_ID];
+}
+
+void ColumnarSensorDatabase::appendRow(u_int32_t sensorId, u_int32_t type,
+                                       const int* data) {
+    modified = true;
+    rowIndex[sensorId - Sensor::MIN_SENSOR_ID] =
+        static_cast<int32_t>(ids.size());
+    ids.push_back(sensorId);
+    types.push_back(static_cast<u_int8_t>(type));
+    values.push_back(data[0]);
+    frameSlots.push_back(hasFrame(type) ? allocateFrame() : NO_ROW);
+    setRowData(ids.size() - 1, data);
+}
+
+void ColumnarSensorDatabase::setRowData(size_t row, const int* data) {
+    modified = true;
+    values[row] = data[0];
+    if (frameSlots[row] != NO_ROW) {
+        memcpy(&frames[frameSlots[row] * Sensor::MAX_DATA_SIZE], data,
+               Sensor::MAX_DATA_SIZE * sizeof(int));
+    }
+}
+
+// Move the last row into the gap so every column stays dense
+void ColumnarSensorDatabase::eraseRow(size_t row) {
+    modified = true;
+    if (frameSlots[row] != NO_ROW) {
+        freeFrames.push_back(frameSlots[row]);
+    }
+    rowIndex[ids[row] - Sensor::MIN_SENSOR_ID] = NO_ROW;
+
+    size_t last = ids.size() - 1;
+    if (row != last) {
+        ids[row] = ids[last];
+        types[row] = types[last];
+        values[row] = values[last];
+        frameSlots[row] = frameSlots[last];
+        rowIndex[ids[row] - Sensor::MIN_SENSOR_ID] = static_cast<int32_t>(row);
+    }
+    ids.pop_back();
+    types.pop_back();
+    values.pop_back();
+    frameSlots.pop_back();
+}
+
+// Reuse a freed frame before growing the frame column
+int32_t ColumnarSensorDatabase::allocateFrame() {
+    if (!freeFrames.empty()) {
+        int32_t slot = freeFrames.back();
+        freeFrames.pop_back();
+        return slot;
+    }
+    int32_t slot = static_cast<int32_t>(frames.size() / Sensor::MAX_DATA_SIZE);
+    frames.resize(frames.size() + Sensor::MAX_DATA_SIZE, 0);
+    return slot;
+}
+
+// Primary sensors always exist, as in SensorDatabase (readings start at 0)
+void ColumnarSensorDatabase::addPrimarySensors() {
+    const struct {
+        u_int32_t sensorId;
+        Sensor::Type type;
+    } primaries[] = {
+        { Hygrometer::PRIMARY_HYGRO_ID, Sensor::HYGROMETER },
+        { AirQualitySensor::PRIMARY_AIR_QUALITY_ID, Sensor::AIR_QUALITY },
+        { LuxMeterSensor::PRIMARY_LUX_ID, Sensor::LUX_METER },
+        { TemperatureSensor::PRIMARY_TEMP_ID, Sensor::TEMPERATURE },
+        { ContactSensor::PRIMARY_CONTACT_ID, Sensor::CONTACT },
+        { ThermalCamera::PRIMARY_THERMAL_ID, Sensor::THERMAL_CAMERA },
+        { RGBCamera::PRIMARY_RGB_ID, Sensor::RGB_CAMERA }
+    };
+
+    const int zeros[Sensor::MAX_DATA_SIZE] = {0};
+    for (const auto& primary : primaries) {
+        if (rowOf(primary.sensorId) == NO_ROW) {
+            appendRow(primary.sensorId, primary.type, zeros);
+        }
+    }
+}
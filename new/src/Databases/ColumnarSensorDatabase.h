@@ -0,0 +1,95 @@
+#ifndef COLUMNARSENSORDATABASE_H
+#define COLUMNARSENSORDATABASE_H
+
+#include <vector>
+#include <cstdint>
+#include "../Sensors/Sensor.h"
+#include "Database.h"
+
+/**
+ * @brief Sensor store laid out as parallel columns (structure of arrays)
+ *
+ * Each sensor is a row spread over dense columns:
+ *
+ *     ids     u_int32_t   sensor ID
+ *     types   u_int8_t    Sensor::Type
+ *     values  int         current reading (data[0])
+ *     frames  int[64]     whole frame, cameras only (indexed per row)
+ *
+ * Bulk scans read only the columns they need: a type histogram touches
+ * one byte per sensor and a threshold check five, instead of pulling a
+ * whole Sensor object (vtable pointer included) through the cache for
+ * each.
+ *
+ * The operations mirror SensorDatabase, but no Sensor objects are kept:
+ * add/update copy the values of a caller-owned sensor and materialize()
+ * builds one on demand. Rows are unordered (a removal moves the last row
+ * into the gap). There is no write-ahead log: changes reach the disk on
+ * saveToFile() and on destruction (only if there were any), in the
+ * compact format. A file whose SensorDatabase log still holds changes is
+ * refused, since saving over it would lose them. Benchmark use only: not
+ * part of the application build.
+ */
+class ColumnarSensorDatabase : public Database {
+public:
+    ColumnarSensorDatabase(const char* filename = "sensors.dat");
+    ~ColumnarSensorDatabase();
+
+    // File Management (inherited from Database)
+    bool loadFromFile(const char* filename) override;
+    bool saveToFile(const char* filename) override;
+    bool clearFile(const char* filename) override;
+
+    // Sensor Management (values are copied; the caller keeps the object)
+    bool addSensor(const Sensor* sensor);
+    bool updateSensor(const Sensor* sensor);
+    bool removeSensor(u_int32_t sensorId);
+    bool changeSensorId(u_int32_t sensorId, u_int32_t newSensorId);
+    bool containsSensor(u_int32_t sensorId) const;
+    void recordReading(const Sensor* sensor) { updateSensor(sensor); }
+
+    // Build a Sensor from a row (caller owns it), nullptr if absent
+    Sensor* materialize(u_int32_t sensorId) const;
+
+    // Column access; row r of every column describes the same sensor
+    size_t getSensorCount() const { return ids.size(); }
+    const std::vector<u_int32_t>& idColumn() const { return ids; }
+    const std::vector<u_int8_t>& typeColumn() const { return types; }
+    const std::vector<int>& valueColumn() const { return values; }
+    const int* frameOf(size_t row) const; // nullptr for scalar sensors
+
+    // Bulk scans
+    size_t countSensorsOfType(Sensor::Type type) const;
+    void countByType(size_t counts[Sensor::TYPE_COUNT]) const;
+    size_t countAbove(Sensor::Type type, int threshold) const;
+    std::vector<char> exportCompact() const; // A whole compact sensors.dat
+
+private:
+    static constexpr int32_t NO_ROW = -1;
+    static constexpr size_t ID_SPACE =
+        Sensor::MAX_SENSOR_ID - Sensor::MIN_SENSOR_ID + 1;
+
+    // Columns
+    std::vector<u_int32_t> ids;
+    std::vector<u_int8_t> types;
+    std::vector<int> values;
+    std::vector<int32_t> frameSlots;  // Frame of each row, NO_ROW if scalar
+
+    // Camera frames, Sensor::MAX_DATA_SIZE values per slot
+    std::vector<int> frames;
+    std::vector<int32_t> freeFrames;
+
+    // Direct-address index: (sensorId - MIN_SENSOR_ID) -> row
+    std::vector<int32_t> rowIndex;
+
+    bool modified;  // Rows changed since loaded or saved to our file
+
+    int32_t rowOf(u_int32_t sensorId) const;
+    void appendRow(u_int32_t sensorId, u_int32_t type, const int* data);
+    void setRowData(size_t row, const int* data);
+    void eraseRow(size_t row);
+    int32_t allocateFrame();
+    void addPrimarySensors();
+};
+
+#endif // COLUMNARSENSORDATABASE_H
@@ -0,0 +1,128 @@
+#include "ContactStateTable.h"
+
+using namespace std;
+
+// Out-of-line definition for the ODR-used constant
+constexpr size_t ContactStateTable::WORD_BITS;
+
+void ContactStateTable::track(u_int32_t sensorId, bool open) {
+    auto it = slotById.find(sensorId);
+    if (it != slotById.end()) {
+        assignBit(openBits, it->second, open);
+        return;
+    }
+
+    u_int32_t slot = static_cast<u_int32_t>(slotIds.size());
+    if (slot % WORD_BITS == 0) {
+        openBits.push_back(0);
+        checkedBits.push_back(0);
+    }
+    slotIds.push_back(sensorId);
+    slotById[sensorId] = slot;
+    assignBit(openBits, slot, open);
+    assignBit(checkedBits, slot, false);
+}
+
+// Move the last slot into the freed one, bits included
+void ContactStateTable::untrack(u_int32_t sensorId) {
+    auto it = slotById.find(sensorId);
+    if (it == slotById.end()) {
+        return;
+    }
+
+    u_int32_t slot = it->second;
+    u_int32_t last = static_cast<u_int32_t>(slotIds.size() - 1);
+    slotById.erase(it);
+    if (slot != last) {
+        slotIds[slot] = slotIds[last];
+        slotById[slotIds[slot]] = slot;
+        assignBit(openBits, slot, testBit(openBits, last));
+        assignBit(checkedBits, slot, testBit(checkedBits, last));
+    }
+    assignBit(openBits, last, false);
+    assignBit(checkedBits, last, false);
+    slotIds.pop_back();
+    if (slotIds.size() % WORD_BITS == 0) {
+        openBits.pop_back();
+        checkedBits.pop_back();
+    }
+}
+
+void ContactStateTable::rekey(u_int32_t oldSensorId, u_int32_t newSensorId) {
+    auto it = slotById.find(oldSensorId);
+    if (it == slotById.end()) {
+        return;
+    }
+    u_int32_t slot = it->second;
+    slotById.erase(it);
+    slotById[newSensorId] = slot;
+    slotIds[slot] = newSensorId;
+}
+
+void ContactStateTable::clear() {
+    openBits.clear();
+    checkedBits.clear();
+    slotIds.clear();
+    slotById.clear();
+}
+
+void ContactStateTable::setOpen(u_int32_t sensorId, bool open) {
+    auto it = slotById.find(sensorId);
+    if (it != slotById.end()) {
+        assignBit(openBits, it->second, open);
+    }
+}
+
+bool ContactStateTable::isOpen(u_int32_t sensorId) const {
+    auto it = slotById.find(sensorId);
+    return it != slotById.end() && testBit(openBits, it->second);
+}
+
+bool ContactStateTable::isTracked(u_int32_t sensorId) const {
+    return slotById.count(sensorId) != 0;
+}
+
+bool ContactStateTable::anyOpen() const {
+    u_int64_t any = 0;
+    for (u_int64_t word : openBits) {
+        any |= word;
+    }
+    return any != 0;
+}
+
+size_t ContactStateTable::countOpen() const {
+    size_t count = 0;
+    for (u_int64_t word : openBits) {
+        count += __builtin_popcountll(word);
+    }
+    return count;
+}
+
+// Bits set now but not at the last take, walked with count-trailing-zeros
+vector<u_int32_t> ContactStateTable::takeNewlyOpened() {
+    vector<u_int32_t> opened;
+    for (size_t word = 0; word < openBits.size(); word++) {
+        u_int64_t rising = openBits[word] & ~checkedBits[word];
+        while (rising != 0) {
+            size_t bit = __builtin_ctzll(rising);
+            opened.push_back(slotIds[word * WORD_BITS + bit]);
+            rising &= rising - 1;
+        }
+        checkedBits[word] = openBits[word];
+    }
+    return opened;
+}
+
+bool ContactStateTable::testBit(const vector<u_int64_t>& bits, size_t slot) {
+    return (bits[slot / WORD_BITS] >> (slot % WORD_BITS)) & 1;
+}
+
+void ContactStateTable::assignBit(vector<u_int64_t>& bits, size_t slot,
+                                  bool value) {
+    u_int64_t mask = u_int64_t(1) << (slot % WORD_BITS);
+    if (value) {
+        bits[slot / WORD_BITS] |= mask;
+    } else {
+        bits[slot / WORD_BITS] &= ~mask;
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef CONTACTSTATETABLE_H
+#define CONTACTSTATETABLE_H
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <sys/types.h>
+
+/**
+ * @brief Open/closed state of every contact sensor, one bit per sensor
+ *
+ * Each tracked sensor owns a slot; bit 'slot' of 'openBits' is set while
+ * its contact is open. Perimeter queries run over 64 sensors per word:
+ * anyOpen() ORs the words, countOpen() popcounts them and
+ * takeNewlyOpened() diffs them against the bitmap of the previous call.
+ *
+ * Slots stay dense: removing a sensor moves the last slot into the gap,
+ * together with its bit in both bitmaps.
+ */
+class ContactStateTable {
+public:
+    // Membership
+    void track(u_int32_t sensorId, bool open);     // Add or overwrite
+    void untrack(u_int32_t sensorId);
+    void rekey(u_int32_t oldSensorId, u_int32_t newSensorId);
+    void clear();
+
+    // State (ignored for untracked IDs)
+    void setOpen(u_int32_t sensorId, bool open);
+    bool isOpen(u_int32_t sensorId) const;
+    bool isTracked(u_int32_t sensorId) const;
+
+    // Perimeter queries
+    size_t size() const { return slotIds.size(); }
+    bool anyOpen() const;
+    size_t countOpen() const;
+
+    /**
+     * @brief Sensors that opened since the previous call
+     *
+     * Sets the baseline to the current state, so each opening is reported
+     * once. Sensors tracked since the previous call count as opened if
+     * they are open now.
+     */
+    std::vector<u_int32_t> takeNewlyOpened();
+
+private:
+    static constexpr size_t WORD_BITS = 64;
+
+    std::vector<u_int64_t> openBits;     // Current state, bit per slot
+    std::vector<u_int64_t> checkedBits;  // openBits at the last take
+    std::vector<u_int32_t> slotIds;      // Sensor ID of each slot
+    std::unordered_map<u_int32_t, u_int32_t> slotById;
+
+    static bool testBit(const std::vector<u_int64_t>& bits, size_t slot);
+    static void assignBit(std::vector<u_int64_t>& bits, size_t slot,
+                          bool value);
+};
+
+#endif // CONTACTSTATETABLE_H
@@ -1,4 +1,8 @@
 #include "Database.h"
+#include <iostream>
+#include <cstring>
+
+using namespace std;
 
 // Virtual destructor implementation
 Database::~Database() {
@@ -22,4 +26,21 @@ bool Database::clearFile(const char* filename) {
     // Mark parameter as unused to avoid compiler warnings
     (void)filename;
     return false;
-}
\ No newline at end of file
+}
+
+void Database::setFilename(const char* name) {
+    // Copy the name to the member variable with bounds checking
+    strncpy(filename, name, MAX_STR - 1);
+    filename[MAX_STR - 1] = '\0'; // Ensure null termination
+    
+    // Make sure the filename has .dat extension
+    size_t len = strlen(filename);
+    if (len < 4 || strcmp(filename + len - 4, ".dat") != 0) {
+        // If filename doesn't end with .dat, append it (if there's space)
+        if (len + 4 < MAX_STR) {
+            strcat(filename, ".dat");
+        } else {
+            cerr << "Warning: Filename too long to append .dat extension\n";
+        }
+    }
+}
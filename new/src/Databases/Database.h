@@ -11,9 +11,14 @@ public:
     virtual bool clearFile(const char* filename) = 0;
     virtual ~Database();
 
+    const char* getFilename() const { return filename; }
+
 protected:
     static constexpr std::size_t MAX_STR = 256; // 255 characters + '\0'
     char filename[MAX_STR];
+
+    // Copy 'name' into 'filename', adding the .dat extension if missing
+    void setFilename(const char* name);
 };
 
 #endif // DATABASE_H
\ No newline at end of file
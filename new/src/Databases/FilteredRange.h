@@ -0,0 +1,69 @@
+#ifndef FILTEREDRANGE_H
+#define FILTEREDRANGE_H
+
+#include <cstddef>
+
+/**
+ * @brief Read-only view over the elements of a container that match a
+ * predicate
+ *
+ * Iterates the database's own container in place: nothing is copied and
+ * nothing is allocated, non-matching elements are skipped as the iterator
+ * advances. Used by SensorDatabase::getSensors() and
+ * UserDatabase::getUsers() with their ByType/ByIdRange/ByRole/ByNumberRange
+ * predicates.
+ *
+ * @note The view is invalidated by any add/remove on the database
+ */
+template <typename Container, typename Predicate>
+class FilteredRange {
+public:
+    typedef typename Container::value_type value_type;
+    typedef typename Container::const_iterator base_iterator;
+
+    class iterator {
+    public:
+        iterator(base_iterator it, base_iterator last, const Predicate* match)
+            : it(it), last(last), match(match) { skip(); }
+
+        value_type operator*() const { return *it; }
+        iterator& operator++() { ++it; skip(); return *this; }
+        bool operator==(const iterator& other) const { return it == other.it; }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+
+    private:
+        void skip() {
+            while (it != last && !(*match)(*it)) {
+                ++it;
+            }
+        }
+
+        base_iterator it;
+        base_iterator last;
+        const Predicate* match;
+    };
+
+    FilteredRange(const Container& items, Predicate match)
+        : items(&items), match(match) {}
+
+    iterator begin() const {
+        return iterator(items->begin(), items->end(), &match);
+    }
+    iterator end() const { return iterator(items->end(), items->end(), &match); }
+    bool empty() const { return !(begin() != end()); }
+
+    // Number of matching elements (walks the container)
+    size_t count() const {
+        size_t matches = 0;
+        for (iterator it = begin(); it != end(); ++it) {
+            matches++;
+        }
+        return matches;
+    }
+
+private:
+    const Container* items;
+    Predicate match;
+};
+
+#endif // FILTEREDRANGE_H
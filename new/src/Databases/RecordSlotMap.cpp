@@ -0,0 +1,177 @@
+#include "RecordSlotMap.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace std;
+
+// Out-of-line definition for the ODR-used constant
+constexpr int32_t RecordSlotMap::NO_SLOT;
+
+RecordSlotMap::RecordSlotMap(u_int32_t minKey, u_int32_t maxKey,
+                             size_t recordSize)
+    : minKey(minKey), recordSize(recordSize), slotCount_(0),
+      slotByKey(maxKey - minKey + 1, NO_SLOT),
+      dirtyFlags(maxKey - minKey + 1, false) {
+}
+
+void RecordSlotMap::assign(u_int32_t key, u_int32_t slot) {
+    slotByKey[indexOf(key)] = static_cast<int32_t>(slot);
+    if (slot >= slotCount_) {
+        slotCount_ = slot + 1;
+    }
+}
+
+void RecordSlotMap::freeSlot(u_int32_t slot) {
+    freeSlots.push_back(slot);
+    tombstones.push_back(slot);
+    if (slot >= slotCount_) {
+        slotCount_ = slot + 1;
+    }
+}
+
+void RecordSlotMap::setSlotCount(u_int32_t count) {
+    slotCount_ = count;
+}
+
+// The file was rewritten sequentially: slot i holds keysInFileOrder[i]
+void RecordSlotMap::rebuild(const vector<u_int32_t>& keysInFileOrder) {
+    fill(slotByKey.begin(), slotByKey.end(), NO_SLOT);
+    for (u_int32_t key : dirtyKeys) {
+        dirtyFlags[indexOf(key)] = false;
+    }
+    dirtyKeys.clear();
+    freeSlots.clear();
+    tombstones.clear();
+
+    slotCount_ = 0;
+    for (u_int32_t key : keysInFileOrder) {
+        assign(key, slotCount_);
+    }
+}
+
+void RecordSlotMap::markDirty(u_int32_t key) {
+    size_t index = indexOf(key);
+    if (!dirtyFlags[index]) {
+        dirtyFlags[index] = true;
+        dirtyKeys.push_back(key);
+    }
+}
+
+void RecordSlotMap::release(u_int32_t key) {
+    int32_t slot = slotByKey[indexOf(key)];
+    if (slot != NO_SLOT) {
+        slotByKey[indexOf(key)] = NO_SLOT;
+        freeSlots.push_back(static_cast<u_int32_t>(slot));
+        tombstones.push_back(static_cast<u_int32_t>(slot));
+    }
+}
+
+// The object keeps its slot under the new key; the record must be rewritten
+void RecordSlotMap::rekey(u_int32_t oldKey, u_int32_t newKey) {
+    slotByKey[indexOf(newKey)] = slotByKey[indexOf(oldKey)];
+    slotByKey[indexOf(oldKey)] = NO_SLOT;
+    markDirty(newKey);
+}
+
+int32_t RecordSlotMap::slotOf(u_int32_t key) const {
+    return slotByKey[indexOf(key)];
+}
+
+// Reuse a freed slot before growing the file
+u_int32_t RecordSlotMap::allocateSlot() {
+    if (!freeSlots.empty()) {
+        u_int32_t slot = freeSlots.back();
+        freeSlots.pop_back();
+        return slot;
+    }
+    return slotCount_++;
+}
+
+RecordSlotMap::Image RecordSlotMap::capture(const void* tombstone,
+                                            const RecordWriter& writer) {
+    Image image;
+    image.recordSize = recordSize;
+
+    // Tombstones first: a freed slot may be handed out again below
+    const char* tombstoneBytes = static_cast<const char*>(tombstone);
+    for (u_int32_t slot : tombstones) {
+        image.slots.push_back(slot);
+        image.records.insert(image.records.end(), tombstoneBytes,
+                             tombstoneBytes + recordSize);
+    }
+    tombstones.clear();
+
+    vector<char> record(recordSize);
+    for (u_int32_t key : dirtyKeys) {
+        dirtyFlags[indexOf(key)] = false;
+        if (!writer(key, record.data())) {
+            continue; // Removed after being marked dirty
+        }
+
+        int32_t slot = slotByKey[indexOf(key)];
+        if (slot == NO_SLOT) {
+            slot = static_cast<int32_t>(allocateSlot());
+            slotByKey[indexOf(key)] = slot;
+        }
+        image.slots.push_back(static_cast<u_int32_t>(slot));
+        image.records.insert(image.records.end(), record.begin(),
+                             record.end());
+    }
+    dirtyKeys.clear();
+
+    image.slotCount = slotCount_;
+    return image;
+}
+
+bool RecordSlotMap::write(const char* filename, const Image& image,
+                          size_t* bytesWritten) {
+    if (bytesWritten) {
+        *bytesWritten = 0;
+    }
+
+    int fd = ::open(filename, O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        cerr << "Error: Could not open '" << filename << "' for update: "
+             << strerror(errno) << endl;
+        return false;
+    }
+
+    bool ok = true;
+    size_t written = 0;
+    for (size_t i = 0; i < image.slots.size(); i++) {
+        off_t offset = static_cast<off_t>(image.slots[i]) * image.recordSize;
+        const char* record = image.records.data() + i * image.recordSize;
+        if (pwrite(fd, record, image.recordSize, offset) !=
+                static_cast<ssize_t>(image.recordSize)) {
+            ok = false;
+            break; // Stop rather than write the rest around a gap
+        }
+        written += image.recordSize;
+    }
+
+    // Drop any unreadable tail left behind by an older, longer file
+    off_t expectedSize = static_cast<off_t>(image.slotCount) * image.recordSize;
+    if (lseek(fd, 0, SEEK_END) > expectedSize) {
+        ok = (ftruncate(fd, expectedSize) == 0) && ok;
+    }
+
+    ok = (fsync(fd) == 0) && ok;
+    ::close(fd);
+
+    if (!ok) {
+        cerr << "Error: In-place update of '" << filename << "' failed"
+             << endl;
+    }
+    if (bytesWritten) {
+        *bytesWritten = written;
+    }
+    return ok;
+}
+
+bool RecordSlotMap::flush(const char* filename, const void* tombstone,
+                          const RecordWriter& writer, size_t* bytesWritten) {
+    return write(filename, capture(tombstone, writer), bytesWritten);
+}
@@ -0,0 +1,100 @@
+#ifndef RECORDSLOTMAP_H
+#define RECORDSLOTMAP_H
+
+#include <vector>
+#include <functional>
+#include <cstddef>
+#include <sys/types.h>
+
+/**
+ * @brief On-disk slot bookkeeping for a file of fixed-size records
+ *
+ * Both binary databases store one fixed-size record per object, so each
+ * object can be addressed by its slot (record index) in the file. This
+ * class remembers the slot of every key (sensor ID / user number), which
+ * keys changed since the last save and which slots are free, so a save
+ * only pwrite()s the records that actually changed.
+ *
+ * Removed objects leave a tombstone record in their slot. Tombstones are
+ * the persisted free list: the loader reports them through freeSlot() and
+ * later additions reuse them before the file grows.
+ */
+class RecordSlotMap {
+public:
+    static constexpr int32_t NO_SLOT = -1;
+
+    // Serializes the current record of 'key' into 'out'; returns false if
+    // the key no longer exists
+    typedef std::function<bool(u_int32_t key, void* out)> RecordWriter;
+
+    // Pending writes captured from the map, self-contained so another
+    // thread can apply them while the owner keeps mutating
+    struct Image {
+        size_t recordSize;
+        u_int32_t slotCount;             // File length in records
+        std::vector<u_int32_t> slots;    // Slot of each record below
+        std::vector<char> records;       // slots.size() * recordSize bytes
+    };
+
+    RecordSlotMap(u_int32_t minKey, u_int32_t maxKey, size_t recordSize);
+
+    // Loading
+    void assign(u_int32_t key, u_int32_t slot);   // Record found at 'slot'
+    void freeSlot(u_int32_t slot);                 // Tombstone or stale slot
+    void setSlotCount(u_int32_t count);            // Records scanned
+    void rebuild(const std::vector<u_int32_t>& keysInFileOrder);
+    void reset() { rebuild(std::vector<u_int32_t>()); } // No slots at all
+
+    // Mutations
+    void markDirty(u_int32_t key);
+    void release(u_int32_t key);                   // Key removed
+    void rekey(u_int32_t oldKey, u_int32_t newKey);
+
+    // Queries
+    int32_t slotOf(u_int32_t key) const;
+    size_t dirtyCount() const { return dirtyKeys.size(); }
+    size_t freeCount() const { return freeSlots.size(); }
+    u_int32_t slotCount() const { return slotCount_; }
+
+    /**
+     * @brief Collect tombstones and dirty records, assigning new slots
+     *
+     * Clears the dirty set: the returned image now owns the changes.
+     *
+     * @param tombstone Record written into freed slots
+     * @param writer Callback that serializes a dirty key
+     */
+    Image capture(const void* tombstone, const RecordWriter& writer);
+
+    /**
+     * @brief Apply a captured image in place with pwrite()
+     *
+     * @param filename File to update (created if missing)
+     * @param image Writes returned by capture()
+     * @param bytesWritten Optional output with the bytes written (up to
+     *        the first failed write, where it stops)
+     * @return true if every write and the final fsync succeeded
+     */
+    static bool write(const char* filename, const Image& image,
+                      size_t* bytesWritten = nullptr);
+
+    // capture() + write() on the calling thread
+    bool flush(const char* filename, const void* tombstone,
+               const RecordWriter& writer, size_t* bytesWritten = nullptr);
+
+private:
+    size_t indexOf(u_int32_t key) const { return key - minKey; }
+    u_int32_t allocateSlot();
+
+    u_int32_t minKey;
+    size_t recordSize;
+    u_int32_t slotCount_;                  // Records the file should hold
+
+    std::vector<int32_t> slotByKey;        // (key - minKey) -> slot
+    std::vector<bool> dirtyFlags;          // (key - minKey) -> dirty
+    std::vector<u_int32_t> dirtyKeys;      // Keys to rewrite on flush
+    std::vector<u_int32_t> freeSlots;      // Reusable slots (LIFO)
+    std::vector<u_int32_t> tombstones;     // Freed slots not yet on disk
+};
+
+#endif // RECORDSLOTMAP_H
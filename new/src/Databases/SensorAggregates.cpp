@@ -0,0 +1,62 @@
+#include "SensorAggregates.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+using namespace std;
+
+SensorAggregates::SensorAggregates() {
+    reset();
+}
+
+void SensorAggregates::reset() {
+    memset(types, 0, sizeof(types));
+    sensorCount = 0;
+    primaryCount = 0;
+}
+
+void SensorAggregates::sensorAdded(const Sensor* sensor) {
+    TypeStats& stats = types[sensor->getType()];
+    stats.sensors++;
+    sensorCount++;
+    if (sensor->isPrimarySensor()) {
+        stats.primaries++;
+        primaryCount++;
+    }
+    readingRecorded(sensor);
+}
+
+void SensorAggregates::sensorRemoved(const Sensor* sensor) {
+    TypeStats& stats = types[sensor->getType()];
+    stats.sensors--;
+    sensorCount--;
+    if (sensor->isPrimarySensor()) {
+        stats.primaries--;
+        primaryCount--;
+    }
+}
+
+// The placeholder 0 of a sensor that was never read is not a reading
+void SensorAggregates::readingRecorded(const Sensor* sensor) {
+    if (!sensor->hasReading()) {
+        return;
+    }
+    TypeStats& stats = types[sensor->getType()];
+    int value = sensor->getSingleData();
+    if (stats.readings == 0 || value < stats.minValue) {
+        stats.minValue = value;
+    }
+    if (stats.readings == 0 || value > stats.maxValue) {
+        stats.maxValue = value;
+    }
+    stats.lastValue = value;
+    stats.readings++;
+}
+
+const SensorAggregates::TypeStats& SensorAggregates::forType(
+        Sensor::Type type) const {
+    if (type >= Sensor::TYPE_COUNT) {
+        throw invalid_argument("Unknown sensor type " + to_string(type));
+    }
+    return types[type];
+}
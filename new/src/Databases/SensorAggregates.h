@@ -0,0 +1,50 @@
+#ifndef SENSORAGGREGATES_H
+#define SENSORAGGREGATES_H
+
+#include <cstddef>
+#include "../Sensors/Sensor.h"
+
+/**
+ * @brief Running totals of the sensor table, updated in O(1) per change
+ *
+ * SensorDatabase reports every sensor it adds or removes and every
+ * reading it records, so the status screens read these figures instead
+ * of walking the table.
+ *
+ * Reading figures use a sensor's current value (data[0], the first pixel
+ * for cameras); sensors provisioned without a reading are left out until
+ * they take one. Minimum and maximum are over every reading seen since the
+ * database was opened (loaded values included): they are not recomputed
+ * when a sensor is removed, which would need the values of every other
+ * sensor.
+ */
+class SensorAggregates {
+public:
+    struct TypeStats {
+        size_t sensors;     // Sensors of this type in the table
+        size_t primaries;   // Of those, primary sensors
+        size_t readings;    // Readings seen
+        int minValue;       // Lowest, highest and latest reading (valid
+        int maxValue;       // once 'readings' > 0)
+        int lastValue;
+    };
+
+    SensorAggregates();
+
+    void reset();
+    void sensorAdded(const Sensor* sensor);     // Counts its reading, if any
+    void sensorRemoved(const Sensor* sensor);
+    void readingRecorded(const Sensor* sensor); // Ignored without a reading
+
+    const TypeStats& forType(Sensor::Type type) const;
+    size_t getSensorCount() const { return sensorCount; }
+    size_t getPrimaryCount() const { return primaryCount; }
+    size_t getRegularCount() const { return sensorCount - primaryCount; }
+
+private:
+    TypeStats types[Sensor::TYPE_COUNT];
+    size_t sensorCount;
+    size_t primaryCount;
+};
+
+#endif // SENSORAGGREGATES_H
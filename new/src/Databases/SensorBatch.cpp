@@ -0,0 +1,31 @@
+#include "SensorBatch.h"
+#include "../Sensors/Sensor.h"
+#include <stdexcept>
+
+using namespace std;
+
+SensorBatch::~SensorBatch() {
+    clear();
+}
+
+void SensorBatch::add(Sensor* sensor) {
+    if (!sensor) {
+        throw invalid_argument("Cannot stage null sensor");
+    }
+    operations.push_back(Operation{ADD, sensor->getSensorId(), 0, sensor});
+}
+
+void SensorBatch::remove(u_int32_t sensorId) {
+    operations.push_back(Operation{REMOVE, sensorId, 0, nullptr});
+}
+
+void SensorBatch::changeId(u_int32_t sensorId, u_int32_t newSensorId) {
+    operations.push_back(Operation{CHANGE_ID, sensorId, newSensorId, nullptr});
+}
+
+void SensorBatch::clear() {
+    for (const Operation& operation : operations) {
+        delete operation.sensor;
+    }
+    operations.clear();
+}
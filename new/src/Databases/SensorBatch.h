@@ -0,0 +1,70 @@
+#ifndef SENSORBATCH_H
+#define SENSORBATCH_H
+
+#include <vector>
+#include <cstddef>
+#include <sys/types.h>
+
+class Sensor;
+
+/**
+ * @brief Adds, removals and ID changes staged for SensorDatabase::applyBatch
+ *
+ * Nothing touches the database while a batch is being filled. applyBatch()
+ * validates every operation together and then applies all of them or none,
+ * rebuilding the indexes once and persisting once, so provisioning or
+ * decommissioning thousands of sensors costs one pass instead of one pass
+ * per sensor.
+ *
+ * Every sensor ID may appear in one operation only (both IDs of an ID
+ * change count): the operations are independent of each other, so their
+ * staging order does not matter.
+ *
+ * The batch owns staged sensors until they are applied; sensors still
+ * staged when it is destroyed or cleared are deleted.
+ */
+class SensorBatch {
+public:
+    enum Kind {
+        ADD,
+        REMOVE,
+        CHANGE_ID
+    };
+
+    struct Operation {
+        Kind kind;
+        u_int32_t sensorId;     // Added, removed or current ID
+        u_int32_t newSensorId;  // CHANGE_ID only
+        Sensor* sensor;         // ADD only (owned by the batch)
+    };
+
+    SensorBatch() {}
+    ~SensorBatch();
+
+    // Non-copyable: the batch owns its staged sensors
+    SensorBatch(const SensorBatch&) = delete;
+    SensorBatch& operator=(const SensorBatch&) = delete;
+
+    // Staging (throws invalid_argument for a null sensor)
+    void add(Sensor* sensor);
+    void remove(u_int32_t sensorId);
+    void changeId(u_int32_t sensorId, u_int32_t newSensorId);
+
+    // Drop every staged operation, deleting staged sensors
+    void clear();
+
+    const std::vector<Operation>& getOperations() const { return operations; }
+    size_t size() const { return operations.size(); }
+    bool empty() const { return operations.empty(); }
+
+private:
+    friend class SensorDatabase;
+
+    // Forget the operations once applied (staged sensors now belong to
+    // the database)
+    void release() { operations.clear(); }
+
+    std::vector<Operation> operations;
+};
+
+#endif // SENSORBATCH_H
@@ -3,7 +3,10 @@
 #include <sstream>
 #include <cstring>
 #include <algorithm>
+#include <memory>
+#include <unistd.h>
 #include "SensorDatabase.h"
+#include "SensorFileView.h"
 #include "../Sensors/Sensor.h"
 #include "../Sensors/TemperatureSensor.h"
 #include "../Sensors/Hygrometer.h"
@@ -26,26 +29,54 @@ class SensorFactory;
 
 using namespace std;
 
-// Constructor
-SensorDatabase::SensorDatabase(const char* inputFilename) {
-    // Copy the input filename to the member variable with bounds checking
-    strncpy(this->filename, inputFilename, MAX_STR - 1);
-    this->filename[MAX_STR - 1] = '\0'; // Ensure null termination
-    
-    // Make sure the filename has .dat extension
-    size_t len = strlen(this->filename);
-    if (len < 4 || strcmp(this->filename + len - 4, ".dat") != 0) {
-        // If filename doesn't end with .dat, append it (if there's space)
-        if (len + 4 < MAX_STR) {
-            strcat(this->filename, ".dat");
-        } else {
-            cerr << "Warning: Filename too long to append .dat extension\n";
-        }
+// Out-of-line definitions for the ODR-used constants
+constexpr int32_t SensorDatabase::NO_SLOT;
+constexpr size_t SensorDatabase::ID_SPACE;
+constexpr size_t SensorDatabase::MEMBERSHIP_LOG_LIMIT;
+
+namespace {
+    // Ordering of the ID index: by sensor ID only
+    bool idLess(const SensorIdRange::Entry& a, const SensorIdRange::Entry& b) {
+        return a.first < b.first;
     }
+}
+
+// Constructor
+SensorDatabase::SensorDatabase(const char* inputFilename) 
+    : idIndex(ID_SPACE, NO_SLOT), membershipBase(1),
+      publishedMembership(0), log(nullptr),
+      diskSlots(Sensor::MIN_SENSOR_ID, Sensor::MAX_SENSOR_ID, 
+                sizeof(SensorRecord)),
+      lastSaveBytes(0), fileFormat(SensorFileFormat::COMPACT),
+      snapshotter(nullptr), failuresSeen(0), fullWriteNeeded(false) {
+    setFilename(inputFilename);
 
     // First, load existing sensors from file if it exists
     loadFromFile(this->filename);
 
+    // Then apply the mutations logged after the last checkpoint
+    log = new WriteAheadLog(WriteAheadLog::logPathFor(this->filename), 
+                            sizeof(SensorRecord));
+    auto apply = [this](const WriteAheadLog::Entry& entry) {
+        applyLogEntry(entry);
+    };
+    
+    // A log retired by an unfinished background snapshot comes first
+    size_t replayed = 0;
+    bool hasRetiredLog = (access(log->retiredPath().c_str(), F_OK) == 0);
+    if (hasRetiredLog) {
+        WriteAheadLog retired(log->retiredPath(), sizeof(SensorRecord));
+        replayed += retired.replay(apply);
+    }
+    replayed += log->replay(apply);
+    
+    if (replayed > 0) {
+        cout << "Recovered " << replayed << " logged sensor change(s)" << endl;
+    }
+    if (replayed > 0 || hasRetiredLog) {
+        checkpoint();
+    }
+
     // After loading, check if primary sensors exist and create them if needed
     // Use the actual constants from each sensor class (with their specific names)
     u_int32_t primaryIds[] = {
@@ -81,96 +112,182 @@ SensorDatabase::SensorDatabase(const char* inputFilename) {
             }
             
             if (primarySensor) {
-                this->sensors.push_back(primarySensor);
+                appendSensor(primarySensor);
+                diskSlots.markDirty(id);
             }
         }
     }
+    publishVersion();
 }
 
 // Destructor
 SensorDatabase::~SensorDatabase() {
-    // Save to file before destroying
-    saveToFile(this->filename);
+    // Save to file before destroying (checkpoints the log); if that fails
+    // the log is left on disk to be replayed at the next load
+    if (!tryCheckpoint()) {
+        log->commit();
+    }
+    setSnapshotCadence(0); // Stops the persistence thread
+    delete log;
     
-    // Free memory for all sensors
+    // Free memory for all sensors, retired ones included
     for (auto sensor : sensors) {
         delete sensor;
     }
+    reclaimer.reclaim();
 
     sensors.clear();
+    slotIds.clear();
+    idOrder.clear();
+    for (auto& members : sensorsByType) {
+        members.clear();
+    }
+    SensorFactory::releaseUnusedMemory();
 }
 
 bool SensorDatabase::loadFromFile(const char* filename) {
-    // Open file in binary mode
-    ifstream file(filename, ios::in | ios::binary);
-    if (!file.is_open()) {
+    // Map the file read-only instead of issuing one read() per record
+    SensorFileView view;
+    if (!view.open(filename)) {
         cerr << "Warning: Could not open file '" 
             << filename << "' for reading." << endl;
         return false;
     }
 
-    // Read records until end of file
-    Sensor* sensor = nullptr;
-    while ((sensor = SensorFactory::readSensorFromFile(file)) != nullptr) {
-        // Check for duplicates by ID
-        if (findSensorById(sensor->getSensorId()) == nullptr) {
-            sensors.push_back(sensor);
-        } else {
-            cerr << "Warning: Duplicate sensor with ID " 
-                 << sensor->getSensorId() << " ignored" << endl;
-            delete sensor; // Clean up if duplicate
+    // Our own file keeps the layout it was found in. Its fixed records are
+    // remembered by slot for in-place saves; sensors taken from any other
+    // file are new to it
+    bool ownFile = isOwnFile(filename);
+    if (ownFile && 
+        (view.format() == SensorFileFormat::COMPACT || view.fileSize() > 0)) {
+        fileFormat = view.format();
+    }
+    bool slotted = ownFile && fileFormat == SensorFileFormat::FIXED_RECORDS;
+    
+    // Walk the records in place until the first invalid one
+    u_int32_t slot = 0;
+    for (; slot < view.recordCount(); slot++) {
+        const SensorRecord& record = view[slot];
+        if (SensorFactory::isTombstone(record)) {
+            if (slotted) {
+                diskSlots.freeSlot(slot);
+            }
+            continue;
+        }
+        if (!SensorFactory::isValidRecord(record)) {
+            break;
+        }
+        
+        // Check for duplicates by ID before building the object
+        if (findSensorById(record.sensorId) != nullptr) {
+            if (slotted) {
+                if (diskSlots.slotOf(record.sensorId) == RecordSlotMap::NO_SLOT) {
+                    diskSlots.assign(record.sensorId, slot);
+                } else if (diskSlots.slotOf(record.sensorId) != 
+                           static_cast<int32_t>(slot)) {
+                    diskSlots.freeSlot(slot); // Stale copy
+                }
+            }
+            if (!ownFile) {
+                cerr << "Warning: Duplicate sensor with ID " 
+                     << record.sensorId << " ignored" << endl;
+            }
+            continue; // Reloading our own file is not an error
         }
+        
+        Sensor* sensor = SensorFactory::recordToSensor(record);
+        if (sensor == nullptr) {
+            break;
+        }
+        appendSensor(sensor, false); // Sorted once after the loop
+        if (slotted) {
+            diskSlots.assign(record.sensorId, slot);
+        } else if (!ownFile) {
+            diskSlots.markDirty(record.sensorId);
+        }
+    }
+    
+    // Anything after the first invalid record is overwritten on save
+    if (slotted && slot > diskSlots.slotCount()) {
+        diskSlots.setSlotCount(slot);
+    }
+    sort(idOrder.begin(), idOrder.end(), idLess);
+    if (log) {
+        publishVersion(); // Reload: show the new sensors to readers
     }
 
-    file.close();
     return true;
 }
 
 bool SensorDatabase::saveToFile(const char* filename) {
-    // Open file in binary mode with truncation
-    ofstream file(filename, ios::out | ios::binary | ios::trunc);
-    if (!file.is_open()) {
-        throw runtime_error("Could not open file for writing.");
+    if (!isOwnFile(filename)) {
+        // Any other file gets a full copy in our layout
+        return writeSnapshot(filename, fileFormat);
     }
-
-    // Write each sensor as a binary record
-    for (auto sensor : sensors) {
-        SensorFactory::writeSensorToFile(file, sensor);
+    
+    // Fixed records are updated in place, slot by slot; a compact file is
+    // small enough to be rewritten whole
+    waitForSnapshots();
+    bool inPlace = (fileFormat == SensorFileFormat::FIXED_RECORDS && 
+                    !fullWriteNeeded);
+    bool saved = inPlace ? flushDirtySlots() : rewriteOwnFile();
+    if (!saved) {
+        return false; // Keep the log: it still covers the changes
     }
-
-    file.close();
+    finishCheckpoint();
     return true;
 }
 
 bool SensorDatabase::clearFile(const char* filename) {
     // First, identify and preserve primary sensors (like default admin preservation)
     vector<Sensor*> primarySensors;
+    vector<Sensor*> removedSensors;
     
-    for (auto it = sensors.begin(); it != sensors.end();) {
-        if ((*it)->isPrimarySensor()) {
-            primarySensors.push_back(*it);
-            it = sensors.erase(it);
+    for (auto sensor : sensors) {
+        if (sensor->isPrimarySensor()) {
+            primarySensors.push_back(sensor);
         } else {
-            delete *it;  // Free memory
-            it = sensors.erase(it);
+            diskSlots.release(sensor->getSensorId());
+            history.forget(sensor->getSensorId());
+            aggregates.sensorRemoved(sensor);
+            removedSensors.push_back(sensor);
         }
     }
     
-    // Put primary sensors back
-    sensors = primarySensors;
-    
-    // Open file in binary mode with truncation
-    ofstream file(filename, ios::out | ios::binary | ios::trunc);
-    if (!file.is_open()) {
-        throw runtime_error("Could not open file for clearing.");
+    // Drop every index entry and put primary sensors back
+    for (u_int32_t sensorId : slotIds) {
+        idIndex[sensorId - Sensor::MIN_SENSOR_ID] = NO_SLOT;
     }
-    
-    // Write the primary sensors back to the file
-    for (auto sensor : sensors) {
-        SensorFactory::writeSensorToFile(file, sensor);
+    usedIds.clear();
+    sensors.clear();
+    slotIds.clear();
+    for (auto& members : sensorsByType) {
+        members.clear();
+    }
+    contactStates.clear();
+    idOrder.clear();
+    for (auto sensor : primarySensors) {
+        aggregates.sensorRemoved(sensor); // Counted again by appendSensor
+        appendSensor(sensor);
     }
+    noteMembershipReset();
+    // Unlinked now: freed once no reader holds them
+    for (auto sensor : removedSensors) {
+        reclaimer.retire(sensor);
+    }
+    reclaimer.reclaim();
+    SensorFactory::releaseUnusedMemory(); // Slabs emptied by the removals
     
-    file.close();
+    // The removals are not logged: persist them through a checkpoint
+    if (isOwnFile(filename)) {
+        rewriteOwnFile();
+        finishCheckpoint();
+    } else {
+        // Write the primary sensors back to the file
+        writeSnapshot(filename, fileFormat);
+        checkpoint();
+    }
+    publishVersion();
     return true;
 }
 
@@ -193,7 +310,8 @@ bool SensorDatabase::addSensor(Sensor* sensor) {
     }
     
     // Add the sensor to the vector
-    sensors.push_back(sensor);
+    appendSensor(sensor);
+    logMutation(WriteAheadLog::ADD, sensor->getSensorId(), sensor);
     return true;
 }
 
@@ -203,17 +321,46 @@ bool SensorDatabase::updateSensor(Sensor* sensor) {
     }
     
     // Find the sensor by ID
-    auto it = find_if(sensors.begin(), sensors.end(),
-                      [sensor](const Sensor* s) {
-                          return s->getSensorId() == sensor->getSensorId();
-                      });
+    int32_t slot = slotOf(sensor->getSensorId());
+    if (slot != NO_SLOT) {
+        // Replace the sensor, retiring the one it replaces once unlinked
+        if (sensors[slot] != sensor) {
+            // Unless it is stored already, under the ID it was moved from
+            // with Sensor::setSensorId onto one in use: put that ID back
+            auto stored = find(sensors.begin(), sensors.end(), sensor);
+            if (stored != sensors.end()) {
+                sensor->setSensorId(slotIds[stored - sensors.begin()]);
+                return false; // Use changeSensorId, which checks the ID
+            }
+            Sensor* previous = sensors[slot];
+            removeFromTypeList(previous);
+            aggregates.sensorRemoved(previous);
+            aggregates.sensorAdded(sensor);
+            contactStates.untrack(sensor->getSensorId());
+            sensorsByType[sensor->getType()].push_back(sensor);
+            sensors[slot] = sensor;
+            findInIdOrder(sensor->getSensorId())->second = sensor;
+            reclaimer.retire(previous);
+            noteMembershipChange(sensor->getSensorId());
+        }
+        refreshContactState(sensor);
+        logMutation(WriteAheadLog::UPDATE, sensor->getSensorId(), sensor);
+        return true;
+    }
     
+    // The ID may have been changed directly through Sensor::setSensorId,
+    // leaving the object indexed under its previous ID
+    auto it = find(sensors.begin(), sensors.end(), sensor);
     if (it == sensors.end()) {
         return false; // Sensor not found
     }
     
-    // Replace the sensor (keeping old pointer for deletion)
-    *it = sensor;
+    slot = static_cast<int32_t>(it - sensors.begin());
+    u_int32_t previousId = slotIds[slot];
+    rekeySlot(slot, sensor->getSensorId());
+    history.rekey(previousId, sensor->getSensorId());
+    refreshContactState(sensor);
+    logMutation(WriteAheadLog::UPDATE, previousId, sensor);
     
     return true;
 }
@@ -240,31 +387,838 @@ bool SensorDatabase::removeSensor(Sensor* sensor) {
     }
     
     // Find sensor in vector
-    auto it = find(sensors.begin(), sensors.end(), sensor);
-    if (it == sensors.end()) {
+    int32_t slot = slotOf(sensor->getSensorId());
+    if (slot == NO_SLOT || sensors[slot] != sensor) {
         throw runtime_error("Sensor not found in database");
     }
     
-    delete *it;
+    u_int32_t sensorId = sensor->getSensorId();
+    logMutation(WriteAheadLog::REMOVE, sensorId, sensor);
+    history.forget(sensorId);
+
+    // Unlink it; readers inside a guard may still hold the pointer
+    eraseSlot(slot);
+    reclaimer.retire(sensor);
+    
+    // Publish it and make it durable right away (one log append, no full
+    // rewrite)
+    commitLog(true);
+    
+    return true;
+}
 
-    // Remove sensor from vector
-    sensors.erase(it);
+/**
+ * @brief Change the ID of a sensor stored in the database
+ * 
+ * Keeps the ID index in sync, so callers must use this method instead of
+ * calling Sensor::setSensorId directly on a stored sensor.
+ * 
+ * @param sensor Pointer to the stored sensor
+ * @param newSensorId New ID, must be free and within the valid range
+ * @return true if the ID was changed, false if the new ID is already in use
+ * @throws invalid_argument if sensor is null or the new ID is out of range
+ * @throws runtime_error if sensor is primary or not found in the database
+ */
+bool SensorDatabase::changeSensorId(Sensor* sensor, u_int32_t newSensorId) {
+    if (!sensor) {
+        throw invalid_argument("Cannot change ID of null sensor");
+    }
+    
+    if (sensor->isPrimarySensor()) {
+        throw runtime_error("Cannot change ID of primary sensor " + 
+                           to_string(sensor->getSensorId()));
+    }
     
-    // Save changes to file
-    saveToFile(filename);
+    int32_t slot = slotOf(sensor->getSensorId());
+    if (slot == NO_SLOT || sensors[slot] != sensor) {
+        throw runtime_error("Sensor not found in database");
+    }
+    
+    if (findSensorById(newSensorId) != nullptr) {
+        return false; // New ID already in use
+    }
+    
+    u_int32_t previousId = sensor->getSensorId();
+    sensor->setSensorId(newSensorId); // Validates the range
+    rekeySlot(slot, newSensorId);
+    history.rekey(previousId, newSensorId);
+    logMutation(WriteAheadLog::UPDATE, previousId, sensor);
     
     return true;
 }
 
+/**
+ * @brief Apply every operation of a batch, or none of them
+ * 
+ * The whole batch is validated first, against the table and against
+ * itself (one hash set of the IDs it touches). The table is then updated
+ * in one pass: removed positions are compacted away together and the new
+ * entries are merged into the ordered index once. Batches that fit in one
+ * log group are logged and committed with a single fsync; larger ones are
+ * folded into a single checkpoint instead of thousands of log entries
+ * (see persistMutations).
+ * 
+ * @param batch Staged operations; emptied once applied (added sensors then
+ *              belong to the database)
+ * @return Number of operations applied
+ * @throws invalid_argument if an ID is out of range
+ * @throws runtime_error if an ID appears in two operations, an added or
+ *         new ID is already in use, or a removed or re-keyed sensor is
+ *         missing or primary. Nothing is applied and the batch is kept
+ */
+size_t SensorDatabase::applyBatch(SensorBatch& batch) {
+    validateBatch(batch);
+    
+    // Mutations to persist once the table is consistent again
+    vector<Mutation> mutations;
+    mutations.reserve(batch.size());
+    
+    // Removals and ID changes work on the existing positions; removed ones
+    // are left empty and compacted below
+    bool anyRemoved = false;
+    for (const SensorBatch::Operation& operation : batch.getOperations()) {
+        if (operation.kind == SensorBatch::ADD) {
+            continue;
+        }
+        int32_t slot = slotOf(operation.sensorId);
+        Sensor* sensor = sensors[slot];
+        
+        if (operation.kind == SensorBatch::REMOVE) {
+            aggregates.sensorRemoved(sensor);
+            contactStates.untrack(operation.sensorId);
+            history.forget(operation.sensorId);
+            idIndex[operation.sensorId - Sensor::MIN_SENSOR_ID] = NO_SLOT;
+            usedIds.markFree(operation.sensorId);
+            noteMembershipChange(operation.sensorId);
+            sensors[slot] = nullptr;
+            anyRemoved = true;
+            mutations.push_back(
+                Mutation{WriteAheadLog::REMOVE, operation.sensorId, sensor});
+        } else {
+            sensor->setSensorId(operation.newSensorId);
+            contactStates.rekey(operation.sensorId, operation.newSensorId);
+            history.rekey(operation.sensorId, operation.newSensorId);
+            idIndex[operation.sensorId - Sensor::MIN_SENSOR_ID] = NO_SLOT;
+            idIndex[operation.newSensorId - Sensor::MIN_SENSOR_ID] = slot;
+            usedIds.markFree(operation.sensorId);
+            usedIds.markUsed(operation.newSensorId);
+            noteMembershipChange(operation.sensorId);
+            noteMembershipChange(operation.newSensorId);
+            slotIds[slot] = operation.newSensorId;
+            mutations.push_back(
+                Mutation{WriteAheadLog::UPDATE, operation.sensorId, sensor});
+        }
+    }
+    if (anyRemoved) {
+        compactSlots();
+    }
+    
+    // Keep the ordered entries still indexed under their key, then merge
+    // the re-keyed and added ones in
+    size_t kept = 0;
+    for (const SensorIdRange::Entry& entry : idOrder) {
+        int32_t slot = slotOf(entry.first);
+        if (slot != NO_SLOT && sensors[slot] == entry.second) {
+            idOrder[kept++] = entry;
+        }
+    }
+    idOrder.resize(kept);
+    for (const Mutation& mutation : mutations) {
+        if (mutation.operation == WriteAheadLog::UPDATE) {
+            idOrder.push_back(SensorIdRange::Entry(
+                mutation.sensor->getSensorId(), mutation.sensor));
+        }
+    }
+    for (const SensorBatch::Operation& operation : batch.getOperations()) {
+        if (operation.kind == SensorBatch::ADD) {
+            appendSensor(operation.sensor, false);
+            mutations.push_back(Mutation{WriteAheadLog::ADD, 
+                operation.sensor->getSensorId(), operation.sensor});
+        }
+    }
+    sort(idOrder.begin() + kept, idOrder.end(), idLess);
+    inplace_merge(idOrder.begin(), idOrder.begin() + kept, idOrder.end(), 
+                  idLess);
+    batch.release();
+    
+    // Unlinked now: freed once no reader holds them (not before commitLog,
+    // so persisting can still read them)
+    for (const Mutation& mutation : mutations) {
+        if (mutation.operation == WriteAheadLog::REMOVE) {
+            reclaimer.retire(mutation.sensor);
+        }
+    }
+    persistMutations(mutations, false); // Does not throw: applied is applied
+    commitLog();
+    
+    return mutations.size();
+}
+
+/**
+ * @brief Provision the sensors of a manifest
+ * 
+ * IDs are reserved in a copy of the used-ID bitmap, entry after entry, so
+ * overlapping ranges never hand out the same ID twice. The sensors are
+ * built without taking a reading and added through one batch.
+ * 
+ * @return Number of sensors added
+ * @throws runtime_error if a range has fewer free IDs than requested
+ *         (nothing is added)
+ */
+size_t SensorDatabase::provision(const SensorManifest& manifest) {
+    SensorIdBitmap reserved = usedIds;
+    vector<u_int32_t> ids;
+    ids.reserve(manifest.getSensorCount());
+    
+    for (const SensorManifest::Entry& entry : manifest.getEntries()) {
+        if (!reserved.allocate(entry.firstId, entry.lastId, entry.count, ids)) {
+            throw runtime_error("Only " + 
+                to_string(reserved.countFree(entry.firstId, entry.lastId)) + 
+                " free IDs between " + to_string(entry.firstId) + " and " + 
+                to_string(entry.lastId) + " for " + to_string(entry.count) + 
+                " " + SensorManifest::typeName(entry.type) + " sensor(s)");
+        }
+    }
+    
+    SensorBatch batch;
+    size_t next = 0;
+    for (const SensorManifest::Entry& entry : manifest.getEntries()) {
+        for (u_int32_t i = 0; i < entry.count; i++) {
+            batch.add(SensorFactory::createUnsampled(entry.type, ids[next++]));
+        }
+    }
+    return applyBatch(batch);
+}
+
 Sensor* SensorDatabase::findSensorById(u_int32_t sensorId) const {
+    int32_t slot = slotOf(sensorId);
+    return (slot == NO_SLOT) ? nullptr : sensors[slot];
+}
+
+const std::vector<Sensor*>& SensorDatabase::getSensorsOfType(
+        Sensor::Type type) const {
+    if (type >= Sensor::TYPE_COUNT) {
+        throw invalid_argument("Unknown sensor type " + to_string(type));
+    }
+    return sensorsByType[type];
+}
+
+size_t SensorDatabase::countSensorsOfType(Sensor::Type type) const {
+    return getSensorsOfType(type).size();
+}
+
+u_int64_t SensorDatabase::getMembershipVersion() const {
+    return membershipBase + membershipChanges.size();
+}
+
+// The IDs come in the order they changed; an ID may appear more than once
+bool SensorDatabase::getMembershipChanges(u_int64_t since,
+        vector<u_int32_t>& sensorIds) const {
+    if (since < membershipBase) {
+        return false;
+    }
+    size_t first = static_cast<size_t>(since - membershipBase);
+    if (first < membershipChanges.size()) {
+        sensorIds.insert(sensorIds.end(), membershipChanges.begin() + first,
+                         membershipChanges.end());
+    }
+    return true;
+}
+
+SensorIdRange SensorDatabase::getSensorsInIdOrder() const {
+    return SensorIdRange(idOrder.begin(), idOrder.end());
+}
+
+// Two binary searches over the ordered index
+SensorIdRange SensorDatabase::getSensorsInIdRange(u_int32_t first, 
+                                                  u_int32_t last) const {
+    if (last > Sensor::MAX_SENSOR_ID) {
+        last = Sensor::MAX_SENSOR_ID; // Keeps 'last + 1' from overflowing
+    }
+    if (first > last) {
+        return SensorIdRange(idOrder.end(), idOrder.end());
+    }
+    auto begin = lower_bound(idOrder.begin(), idOrder.end(), 
+                             SensorIdRange::Entry(first, nullptr), idLess);
+    auto end = lower_bound(begin, idOrder.end(), 
+                           SensorIdRange::Entry(last + 1, nullptr), idLess);
+    return SensorIdRange(begin, end);
+}
+
+// Log a fresh reading so it survives a crash before the next checkpoint,
+// and keep it in the sensor's history
+void SensorDatabase::recordReading(const Sensor* sensor) {
+    if (!sensor) {
+        throw invalid_argument("Cannot record reading of null sensor");
+    }
+    history.record(sensor, ReadingHistory::now());
+    aggregates.readingRecorded(sensor);
+    refreshContactState(sensor);
+    logMutation(WriteAheadLog::READING, sensor->getSensorId(), sensor);
+}
+
+// Readings of a whole sweep: a large sweep rewrites most records anyway, so
+// it is folded into one snapshot instead of one log entry per sensor
+void SensorDatabase::recordReadings(const vector<Sensor*>& sampled) {
+    int64_t timestamp = ReadingHistory::now();
+    vector<Mutation> mutations;
+    mutations.reserve(sampled.size());
+    
+    for (Sensor* sensor : sampled) {
+        if (!sensor) {
+            throw invalid_argument("Cannot record reading of null sensor");
+        }
+        history.record(sensor, timestamp);
+        aggregates.readingRecorded(sensor);
+        refreshContactState(sensor);
+        mutations.push_back(
+            Mutation{WriteAheadLog::READING, sensor->getSensorId(), sensor});
+    }
+    persistMutations(mutations, true);
+}
+
+// Group commit: write every buffered mutation with a single fsync. With
+// background snapshots enabled the write is queued on that thread instead,
+// unless the caller needs it on disk before returning ('sync')
+bool SensorDatabase::commitLog(bool sync) {
+    publishVersion();
+    reclaimer.reclaim();
+    if (snapshotter && !sync) {
+        log->commitAsync();
+        return true;
+    }
+    return log->commit();
+}
+
+SensorTableVersion::Pin SensorDatabase::pinVersion() const {
+    return atomic_load(&publishedVersion);
+}
+
+// Readers holding the previous version keep it alive until they unpin.
+// Nothing is published if nothing changed, and changes of readings alone
+// only copy the version's blocks that hold them
+void SensorDatabase::publishVersion() {
+    u_int64_t membership = getMembershipVersion();
+    bool sameIds = (membership == publishedMembership);
+    if (publishedVersion && sameIds && unpublishedIds.empty()) {
+        return;
+    }
+    SensorTableVersion::Pin next = SensorTableVersion::publish(
+        publishedVersion, idOrder, unpublishedIds, aggregates, sameIds);
+    atomic_store(&publishedVersion, next);
+    publishedMembership = membership;
+    unpublishedIds.clear();
+}
+
+// Fold the log into the snapshot file and start an empty log
+bool SensorDatabase::checkpoint() {
+    return saveToFile(filename);
+}
+
+// Checkpoint after a mutation has been applied: a failed write must not
+// undo it, so it is reported and the log keeps covering the changes
+bool SensorDatabase::tryCheckpoint() {
+    try {
+        return checkpoint();
+    } catch (const exception& e) {
+        cerr << "Error: checkpoint failed, changes kept in the log: " 
+             << e.what() << endl;
+        return false;
+    }
+}
+
+/**
+ * @brief Convert our own file to another on-disk layout
+ * 
+ * The file is rewritten right away; legacy fixed-record files keep their
+ * layout until converted.
+ * 
+ * @param format Layout to use from now on
+ * @return true if the file was rewritten in the new layout
+ */
+bool SensorDatabase::setFileFormat(SensorFileFormat::Format format) {
+    if (format == fileFormat) {
+        return true;
+    }
+    SensorFileFormat::Format previous = fileFormat;
+    fileFormat = format;
+    if (!rewriteOwnFile()) {
+        fileFormat = previous;
+        return false;
+    }
+    finishCheckpoint();
+    return true;
+}
+
+// Write every sensor to a file, replacing its contents
+bool SensorDatabase::writeSnapshot(const char* filename, 
+                                   SensorFileFormat::Format format) {
+    if (format == SensorFileFormat::COMPACT) {
+        if (!SensorFileFormat::writeFile(filename, sensors, &lastSaveBytes)) {
+            throw runtime_error("Could not open file for writing.");
+        }
+        return true;
+    }
+    
+    // Open file in binary mode with truncation
+    ofstream file(filename, ios::out | ios::binary | ios::trunc);
+    if (!file.is_open()) {
+        throw runtime_error("Could not open file for writing.");
+    }
+
+    // Write each sensor as a binary record
     for (auto sensor : sensors) {
-        if (sensor->getSensorId() == sensorId) {
-            return sensor;
+        SensorFactory::writeSensorToFile(file, sensor);
+    }
+
+    file.close();
+    lastSaveBytes = sensors.size() * sizeof(SensorRecord);
+    return true;
+}
+
+// Rewrite our own file whole; the slot map then matches 'sensors' order
+bool SensorDatabase::rewriteOwnFile() {
+    waitForSnapshots();
+    if (!writeSnapshot(filename, fileFormat)) {
+        return false;
+    }
+    fullWriteNeeded = false;
+    if (fileFormat == SensorFileFormat::FIXED_RECORDS) {
+        WriteAheadLog::syncFile(filename);
+        diskSlots.rebuild(slotIds);
+    } else {
+        diskSlots.reset(); // Compact records have no fixed slots
+    }
+    return true;
+}
+
+// Rewrite the changed slots of our own file (tombstones first)
+bool SensorDatabase::flushDirtySlots() {
+    return RecordSlotMap::write(filename, captureDirtySlots(), &lastSaveBytes);
+}
+
+// Copy the changed records out of the live sensors
+RecordSlotMap::Image SensorDatabase::captureDirtySlots() {
+    SensorRecord tombstone = SensorFactory::tombstoneRecord();
+    return diskSlots.capture(&tombstone, 
+        [this](u_int32_t sensorId, void* out) {
+            const Sensor* sensor = findSensorById(sensorId);
+            if (!sensor) {
+                return false;
+            }
+            *static_cast<SensorRecord*>(out) = 
+                SensorFactory::sensorToRecord(sensor);
+            return true;
+        });
+}
+
+/**
+ * @brief Enable, retune or disable background snapshots
+ * 
+ * @param seconds Minimum time between captures; 0 drains the pending
+ *                work, stops the thread and goes back to inline checkpoints
+ */
+void SensorDatabase::setSnapshotCadence(unsigned seconds) {
+    if (seconds == 0) {
+        if (snapshotter) {
+            waitForSnapshots();
+            log->setBackgroundCommit(WriteAheadLog::TaskRunner(), 
+                                     std::function<void()>());
+            delete snapshotter;
+            snapshotter = nullptr;
         }
+        return;
+    }
+    
+    if (snapshotter) {
+        snapshotter->setCadence(seconds);
+        return;
+    }
+    
+    snapshotter = new Snapshotter(seconds);
+    failuresSeen = 0;
+    log->setBackgroundCommit(
+        [this](const std::function<void()>& task) { snapshotter->submit(task); },
+        [this]() { snapshotter->drain(); });
+}
+
+unsigned SensorDatabase::getSnapshotCadence() const {
+    return snapshotter ? snapshotter->getCadence() : 0;
+}
+
+bool SensorDatabase::getSnapshotStats(Snapshotter::Stats& stats) const {
+    if (!snapshotter) {
+        return false;
+    }
+    stats = snapshotter->getStats();
+    return true;
+}
+
+// Capture a point-in-time image and let the persistence thread write it.
+// Only memory copies happen here; the retired log is deleted once the
+// image is durable. False if no snapshot could be started
+bool SensorDatabase::startSnapshot() {
+    if (snapshotter->snapshotPending() || fullWriteNeeded || !log->rotate()) {
+        return false; // Retried at a later mutation
+    }
+    
+    string target(filename);
+    string retiredLog = log->retiredPath();
+    
+    if (fileFormat == SensorFileFormat::FIXED_RECORDS) {
+        std::shared_ptr<RecordSlotMap::Image> image = 
+            std::make_shared<RecordSlotMap::Image>(captureDirtySlots());
+        snapshotter->submitSnapshot([image, target, retiredLog](size_t& bytes) {
+            if (!RecordSlotMap::write(target.c_str(), *image, &bytes)) {
+                return false;
+            }
+            unlink(retiredLog.c_str());
+            return true;
+        });
+    } else {
+        std::shared_ptr<vector<char> > image = std::make_shared<vector<char> >(
+            SensorFileFormat::encodeFile(sensors));
+        snapshotter->submitSnapshot([image, target, retiredLog](size_t& bytes) {
+            if (!SensorFileFormat::writeBuffer(target.c_str(), *image)) {
+                return false;
+            }
+            bytes = image->size();
+            unlink(retiredLog.c_str());
+            return true;
+        });
+    }
+    return true;
+}
+
+// Wait for queued background writes; a failed snapshot means the file no
+// longer matches the slot map, so the next checkpoint rewrites it whole
+void SensorDatabase::waitForSnapshots() {
+    if (!snapshotter) {
+        return;
+    }
+    snapshotter->drain();
+    size_t failed = snapshotter->getStats().failed;
+    if (failed > failuresSeen) {
+        failuresSeen = failed;
+        fullWriteNeeded = true;
+    }
+}
+
+// The file now holds every logged mutation: drop both logs
+void SensorDatabase::finishCheckpoint() {
+    log->truncate();
+    unlink(log->retiredPath().c_str());
+}
+
+// Keep the slot map in step with a mutation: removals free their slot,
+// everything else dirties it (ID changes keep the slot under the new ID)
+void SensorDatabase::trackDiskSlot(WriteAheadLog::Operation operation, 
+                                   u_int32_t key, u_int32_t sensorId) {
+    if (operation == WriteAheadLog::REMOVE) {
+        diskSlots.release(key);
+    } else if (key != sensorId) {
+        diskSlots.rekey(key, sensorId);
+    } else {
+        diskSlots.markDirty(sensorId);
     }
-    return nullptr; // Sensor not found
 }
 
-std::vector<Sensor*> SensorDatabase::getAllSensors() const {
-    return sensors;
-}
\ No newline at end of file
+/**
+ * @brief Persist a bulk change once
+ * 
+ * Sets smaller than a log group are logged like single mutations. Larger
+ * ones only mark their records dirty and are folded into one checkpoint,
+ * or, with 'inBackground' and background snapshots enabled, into one
+ * snapshot written by the persistence thread. If neither can be started,
+ * or the checkpoint fails to write, the mutations go to the log after all.
+ */
+void SensorDatabase::persistMutations(const vector<Mutation>& mutations, 
+                                      bool inBackground) {
+    bool logged = mutations.size() < WriteAheadLog::DEFAULT_GROUP_SIZE;
+    for (const Mutation& mutation : mutations) {
+        if (logged) {
+            logMutation(mutation.operation, mutation.key, mutation.sensor);
+        } else {
+            trackDiskSlot(mutation.operation, mutation.key, 
+                          mutation.sensor->getSensorId());
+            unpublishedIds.insert(mutation.key);
+            unpublishedIds.insert(mutation.sensor->getSensorId());
+        }
+    }
+    if (logged) {
+        return;
+    }
+    
+    bool folded = (inBackground && snapshotter) ? startSnapshot() 
+                                                : tryCheckpoint();
+    if (!folded) {
+        // The file was left behind: keep the changes in the log instead
+        for (const Mutation& mutation : mutations) {
+            SensorRecord record = SensorFactory::sensorToRecord(mutation.sensor);
+            log->append(mutation.operation, mutation.key, &record);
+        }
+    }
+}
+
+void SensorDatabase::logMutation(WriteAheadLog::Operation operation, 
+                                 u_int32_t key, const Sensor* sensor) {
+    trackDiskSlot(operation, key, sensor->getSensorId());
+    unpublishedIds.insert(key);
+    unpublishedIds.insert(sensor->getSensorId());
+    if (!log) {
+        return; // Still loading: nothing to log
+    }
+    SensorRecord record = SensorFactory::sensorToRecord(sensor);
+    log->append(operation, key, &record);
+    
+    if (snapshotter) {
+        if (log->needsCheckpoint() || snapshotter->isDue()) {
+            startSnapshot();
+        }
+    } else if (log->needsCheckpoint()) {
+        tryCheckpoint();
+    }
+}
+
+// Re-apply one logged mutation on top of the loaded snapshot
+void SensorDatabase::applyLogEntry(const WriteAheadLog::Entry& entry) {
+    const SensorRecord& record = 
+        *static_cast<const SensorRecord*>(entry.payload);
+    if (!SensorFactory::isValidRecord(record)) {
+        return;
+    }
+    
+    int32_t slot = slotOf(entry.key);
+    switch (entry.operation) {
+        case WriteAheadLog::ADD:
+            if (slot == NO_SLOT) {
+                Sensor* sensor = SensorFactory::recordToSensor(record);
+                if (sensor) {
+                    appendSensor(sensor);
+                    trackDiskSlot(entry.operation, entry.key, record.sensorId);
+                }
+            }
+            break;
+        case WriteAheadLog::UPDATE:
+            if (slot == NO_SLOT) {
+                break;
+            }
+            if (sensors[slot]->getType() != record.sensorType) {
+                // Replaced by a sensor of another type
+                Sensor* sensor = SensorFactory::recordToSensor(record);
+                if (sensor) {
+                    Sensor* previous = sensors[slot];
+                    eraseSlot(slot);
+                    delete previous;
+                    appendSensor(sensor);
+                    trackDiskSlot(entry.operation, entry.key, record.sensorId);
+                }
+                break;
+            }
+            if (record.sensorId != entry.key) {
+                sensors[slot]->setSensorId(record.sensorId);
+                rekeySlot(slot, record.sensorId);
+            }
+            sensors[slot]->setFullData(record.data);
+            aggregates.readingRecorded(sensors[slot]);
+            refreshContactState(sensors[slot]);
+            trackDiskSlot(entry.operation, entry.key, record.sensorId);
+            break;
+        case WriteAheadLog::REMOVE:
+            if (slot != NO_SLOT && !sensors[slot]->isPrimarySensor()) {
+                Sensor* sensor = sensors[slot];
+                eraseSlot(slot);
+                delete sensor;
+                trackDiskSlot(entry.operation, entry.key, record.sensorId);
+            }
+            break;
+        case WriteAheadLog::READING:
+            if (slot != NO_SLOT) {
+                sensors[slot]->setFullData(record.data);
+                aggregates.readingRecorded(sensors[slot]);
+                refreshContactState(sensors[slot]);
+                trackDiskSlot(entry.operation, entry.key, record.sensorId);
+            }
+            break;
+    }
+}
+
+bool SensorDatabase::isOwnFile(const char* filename) const {
+    return strcmp(filename, this->filename) == 0;
+}
+
+// Look up the position of a sensor ID in O(1)
+int32_t SensorDatabase::slotOf(u_int32_t sensorId) const {
+    if (sensorId < Sensor::MIN_SENSOR_ID || sensorId > Sensor::MAX_SENSOR_ID) {
+        return NO_SLOT;
+    }
+    return idIndex[sensorId - Sensor::MIN_SENSOR_ID];
+}
+
+// Store a sensor at the end of the vector and index it by ID. Bulk loads
+// pass keepIdOrder = false and sort the ordered index once at the end
+void SensorDatabase::appendSensor(Sensor* sensor, bool keepIdOrder) {
+    idIndex[sensor->getSensorId() - Sensor::MIN_SENSOR_ID] = 
+        static_cast<int32_t>(sensors.size());
+    usedIds.markUsed(sensor->getSensorId());
+    noteMembershipChange(sensor->getSensorId());
+    sensors.push_back(sensor);
+    slotIds.push_back(sensor->getSensorId());
+    sensorsByType[sensor->getType()].push_back(sensor);
+    aggregates.sensorAdded(sensor);
+    refreshContactState(sensor);
+
+    SensorIdRange::Entry entry(sensor->getSensorId(), sensor);
+    if (keepIdOrder) {
+        idOrder.insert(upper_bound(idOrder.begin(), idOrder.end(), entry, 
+                                   idLess), entry);
+    } else {
+        idOrder.push_back(entry);
+    }
+}
+
+// Move an indexed position to a new ID key
+void SensorDatabase::rekeySlot(int32_t slot, u_int32_t newSensorId) {
+    contactStates.rekey(slotIds[slot], newSensorId);
+    idOrder.erase(findInIdOrder(slotIds[slot]));
+    SensorIdRange::Entry entry(newSensorId, sensors[slot]);
+    idOrder.insert(upper_bound(idOrder.begin(), idOrder.end(), entry, idLess),
+                   entry);
+    idIndex[slotIds[slot] - Sensor::MIN_SENSOR_ID] = NO_SLOT;
+    idIndex[newSensorId - Sensor::MIN_SENSOR_ID] = slot;
+    usedIds.markFree(slotIds[slot]);
+    usedIds.markUsed(newSensorId);
+    noteMembershipChange(slotIds[slot]);
+    noteMembershipChange(newSensorId);
+    slotIds[slot] = newSensorId;
+}
+
+// Remove a position keeping insertion order; shifted sensors are re-indexed
+void SensorDatabase::eraseSlot(size_t slot) {
+    removeFromTypeList(sensors[slot]);
+    aggregates.sensorRemoved(sensors[slot]);
+    contactStates.untrack(slotIds[slot]);
+    idOrder.erase(findInIdOrder(slotIds[slot]));
+    idIndex[slotIds[slot] - Sensor::MIN_SENSOR_ID] = NO_SLOT;
+    usedIds.markFree(slotIds[slot]);
+    noteMembershipChange(slotIds[slot]);
+    sensors.erase(sensors.begin() + slot);
+    slotIds.erase(slotIds.begin() + slot);
+    
+    for (size_t i = slot; i < sensors.size(); i++) {
+        idIndex[slotIds[i] - Sensor::MIN_SENSOR_ID] = static_cast<int32_t>(i);
+    }
+}
+
+// A full list is dropped rather than grown: bulk loads would otherwise
+// keep one entry per sensor that nobody reads
+void SensorDatabase::noteMembershipChange(u_int32_t sensorId) {
+    if (membershipChanges.size() == MEMBERSHIP_LOG_LIMIT) {
+        noteMembershipReset();
+    }
+    membershipChanges.push_back(sensorId);
+}
+
+// Every observer rescans: the next version is past anything they hold
+void SensorDatabase::noteMembershipReset() {
+    membershipBase += membershipChanges.size() + 1;
+    membershipChanges.clear();
+}
+
+// Close the gaps left by batch removals (null positions) in one pass,
+// keeping insertion order; type lists drop sensors no longer indexed
+void SensorDatabase::compactSlots() {
+    size_t kept = 0;
+    for (size_t i = 0; i < sensors.size(); i++) {
+        if (sensors[i] != nullptr) {
+            sensors[kept] = sensors[i];
+            slotIds[kept] = slotIds[i];
+            idIndex[slotIds[kept] - Sensor::MIN_SENSOR_ID] = 
+                static_cast<int32_t>(kept);
+            kept++;
+        }
+    }
+    sensors.resize(kept);
+    slotIds.resize(kept);
+    
+    for (auto& members : sensorsByType) {
+        members.erase(remove_if(members.begin(), members.end(),
+            [this](const Sensor* sensor) {
+                int32_t slot = slotOf(sensor->getSensorId());
+                return slot == NO_SLOT || sensors[slot] != sensor;
+            }), members.end());
+    }
+}
+
+// Check a whole batch before any of it is applied. Each ID may be claimed
+// by one operation only, which also rules out duplicate adds
+void SensorDatabase::validateBatch(const SensorBatch& batch) const {
+    unordered_set<u_int32_t> claimed;
+    claimed.reserve(batch.size() * 2);
+    auto claim = [&claimed](u_int32_t sensorId) {
+        if (sensorId < Sensor::MIN_SENSOR_ID || 
+            sensorId > Sensor::MAX_SENSOR_ID) {
+            throw invalid_argument("Sensor ID must be between " + 
+                                  to_string(Sensor::MIN_SENSOR_ID) + " and " + 
+                                  to_string(Sensor::MAX_SENSOR_ID));
+        }
+        if (!claimed.insert(sensorId).second) {
+            throw runtime_error("Sensor ID " + to_string(sensorId) + 
+                               " appears in more than one batch operation");
+        }
+    };
+    
+    for (const SensorBatch::Operation& operation : batch.getOperations()) {
+        if (operation.kind == SensorBatch::ADD) {
+            u_int32_t sensorId = operation.sensor->getSensorId();
+            claim(sensorId);
+            if (findSensorById(sensorId) != nullptr) {
+                throw runtime_error("Sensor with ID " + to_string(sensorId) + 
+                                   " already exists");
+            }
+            continue;
+        }
+        
+        claim(operation.sensorId);
+        const Sensor* sensor = findSensorById(operation.sensorId);
+        if (sensor == nullptr) {
+            throw runtime_error("Sensor " + to_string(operation.sensorId) + 
+                               " not found in database");
+        }
+        if (sensor->isPrimarySensor()) {
+            throw runtime_error("Cannot remove or re-key primary sensor " + 
+                               to_string(operation.sensorId));
+        }
+        if (operation.kind == SensorBatch::CHANGE_ID) {
+            claim(operation.newSensorId);
+            if (findSensorById(operation.newSensorId) != nullptr) {
+                throw runtime_error("Sensor with ID " + 
+                                   to_string(operation.newSensorId) + 
+                                   " already exists");
+            }
+        }
+    }
+}
+
+// Drop a sensor from its per-type list, O(#sensors of that type)
+void SensorDatabase::removeFromTypeList(Sensor* sensor) {
+    vector<Sensor*>& members = sensorsByType[sensor->getType()];
+    auto it = find(members.begin(), members.end(), sensor);
+    if (it != members.end()) {
+        members.erase(it);
+    }
+}
+
+// Mirror a contact sensor's reading (1 = open) into the state bitmap
+void SensorDatabase::refreshContactState(const Sensor* sensor) {
+    if (sensor->getType() == Sensor::CONTACT) {
+        contactStates.track(sensor->getSensorId(), sensor->getSingleData() == 1);
+    }
+}
+
+// Entry of an indexed ID in the ordered index (binary search)
+vector<SensorIdRange::Entry>::iterator SensorDatabase::findInIdOrder(
+        u_int32_t sensorId) {
+    return lower_bound(idOrder.begin(), idOrder.end(), 
+                       SensorIdRange::Entry(sensorId, nullptr), idLess);
+}
@@ -5,11 +5,46 @@
 #include <string>
 #include "../Sensors/Sensor.h"
 #include "Database.h"
+#include "SensorTypeRange.h"
+#include "SensorIdRange.h"
+#include "FilteredRange.h"
+#include "WriteAheadLog.h"
+#include "RecordSlotMap.h"
+#include "SensorFileFormat.h"
+#include "../History/ReadingHistory.h"
+#include "Snapshotter.h"
+#include "ContactStateTable.h"
+#include "SensorAggregates.h"
+#include "SensorTableVersion.h"
+#include "SensorBatch.h"
+#include "SensorIdBitmap.h"
+#include "SensorManifest.h"
+#include "../Utils/EpochReclaimer.h"
+#include <unordered_set>
 
 class Sensor;
 
 class SensorDatabase : public Database {
 public:
+    // Predicates for getSensors() / forEachSensor()
+    struct ByType {
+        explicit ByType(Sensor::Type type) : type(type) {}
+        bool operator()(const Sensor* sensor) const { 
+            return sensor->getType() == type; 
+        }
+        Sensor::Type type;
+    };
+
+    struct ByIdRange {
+        ByIdRange(u_int32_t first, u_int32_t last) : first(first), last(last) {}
+        bool operator()(const Sensor* sensor) const {
+            return sensor->getSensorId() >= first && 
+                   sensor->getSensorId() <= last;
+        }
+        u_int32_t first;
+        u_int32_t last;
+    };
+
     SensorDatabase(const char* filename = "sensors.dat");
     ~SensorDatabase();
 
@@ -20,15 +55,211 @@ public:
 
     // Sensor Management
     bool addSensor(Sensor* sensor);
+    // Store the changes of a stored sensor, or replace the one with its ID
+    // by a new object. False if not stored, or if its ID was changed with
+    // Sensor::setSensorId to one in use (changed back; see changeSensorId)
     bool updateSensor(Sensor* sensor);
     bool removeSensor(Sensor* sensor);
+    bool changeSensorId(Sensor* sensor, u_int32_t newSensorId);
     Sensor* findSensorById(u_int32_t sensorId) const;
 
-    // Single getter 
-    std::vector<Sensor*> getAllSensors() const;
+    // Bulk changes: validated together, applied all-or-nothing with one
+    // index rebuild and one commit (see SensorBatch)
+    size_t applyBatch(SensorBatch& batch);
+
+    // Add every sensor of a manifest in one batch, on the lowest free IDs
+    // of each entry's range; the new sensors take no reading
+    size_t provision(const SensorManifest& manifest);
+
+    // IDs in use (kept in sync with the ID index)
+    const SensorIdBitmap& getUsedIds() const { return usedIds; }
+
+    // Durability (write-ahead log + snapshot checkpoints)
+    void recordReading(const Sensor* sensor);
+    // Same for a whole collection sweep: one timestamp, persisted once
+    void recordReadings(const std::vector<Sensor*>& sampled);
+    // sync = true writes on this thread even with background snapshots
+    bool commitLog(bool sync = false);
+    bool checkpoint();
+    size_t getLastSaveBytes() const { return lastSaveBytes; }
+
+    // Background snapshots: checkpoints are captured in memory and written
+    // by a persistence thread every 'seconds' (0 = inline checkpoints)
+    void setSnapshotCadence(unsigned seconds);
+    unsigned getSnapshotCadence() const;
+    bool getSnapshotStats(Snapshotter::Stats& stats) const;
+
+    // Removed and replaced sensors are retired here instead of deleted:
+    // code that holds Sensor* across other operations (collection, alarm
+    // captures) does so inside an EpochReclaimer::Guard on it
+    EpochReclaimer& getReclaimer() { return reclaimer; }
+
+    // Read-only versions of the table: readers pin the latest published
+    // one and never wait for writers. commitLog() publishes a new version
+    SensorTableVersion::Pin pinVersion() const;
+    void publishVersion();
+
+    // Time-series of every reading passed to recordReading()
+    const ReadingHistory& getHistory() const { return history; }
+
+    // On-disk layout of our own file (detected on load, kept on save)
+    SensorFileFormat::Format getFileFormat() const { return fileFormat; }
+    bool setFileFormat(SensorFileFormat::Format format);
+
+    // In-place access to every sensor, in insertion order (no copies;
+    // invalidated by add/remove)
+    const std::vector<Sensor*>& getAllSensors() const { return sensors; }
+    size_t getSensorCount() const { return sensors.size(); }
+
+    // Sensors matching a predicate, e.g. getSensors(ByIdRange(20000, 29999))
+    template <typename Predicate>
+    FilteredRange<std::vector<Sensor*>, Predicate> getSensors(
+            Predicate match) const {
+        return FilteredRange<std::vector<Sensor*>, Predicate>(sensors, match);
+    }
+
+    // Call visit(Sensor*) on every sensor, or on those matching 'match'
+    template <typename Visitor>
+    void forEachSensor(Visitor visit) const {
+        for (Sensor* sensor : sensors) {
+            visit(sensor);
+        }
+    }
+
+    template <typename Predicate, typename Visitor>
+    void forEachSensor(Predicate match, Visitor visit) const {
+        for (Sensor* sensor : sensors) {
+            if (match(sensor)) {
+                visit(sensor);
+            }
+        }
+    }
+
+    // Ascending ID order (sorted index kept in sync on add/remove/ID
+    // change), e.g. getSensorsInIdRange(30000, 39999) for every lux meter
+    SensorIdRange getSensorsInIdOrder() const;
+    SensorIdRange getSensorsInIdRange(u_int32_t first, u_int32_t last) const;
+
+    // Counts and reading ranges per type, maintained on every change
+    const SensorAggregates& getAggregates() const { return aggregates; }
+
+    // Per-type access (membership lists kept in sync on add/remove/load)
+    const std::vector<Sensor*>& getSensorsOfType(Sensor::Type type) const;
+    size_t countSensorsOfType(Sensor::Type type) const;
+
+    // Typed view, e.g. getSensorsOfType<RGBCamera>() yields RGBCamera*
+    template <typename T>
+    SensorTypeRange<T> getSensorsOfType() const {
+        return SensorTypeRange<T>(sensorsByType[T::SENSOR_TYPE]);
+    }
+
+    // Sensors added, removed, re-keyed or replaced, for observers that
+    // follow the table incrementally: remember getMembershipVersion() and
+    // later ask for the IDs changed since. False if that is too far back
+    // (or the table was reloaded or cleared): rescan every sensor
+    u_int64_t getMembershipVersion() const;
+    bool getMembershipChanges(u_int64_t since,
+                              std::vector<u_int32_t>& sensorIds) const;
+
+    // Open/closed bit of every contact sensor (kept in sync on add/remove,
+    // update and recordReading)
+    const ContactStateTable& getContactStates() const { return contactStates; }
+    std::vector<u_int32_t> takeNewlyOpenedContacts() {
+        return contactStates.takeNewlyOpened();
+    }
 
 private:
+    static constexpr int32_t NO_SLOT = -1;
+    static constexpr size_t ID_SPACE = 
+        Sensor::MAX_SENSOR_ID - Sensor::MIN_SENSOR_ID + 1;
+
     std::vector<Sensor*> sensors;
+    
+    // Direct-address index: (sensorId - MIN_SENSOR_ID) -> position in 'sensors'
+    std::vector<int32_t> idIndex;
+    // ID under which each position of 'sensors' is indexed (same size)
+    std::vector<u_int32_t> slotIds;
+    // Same IDs as a bitmap, for free-ID searches
+    SensorIdBitmap usedIds;
+    // Secondary index: sensors grouped by Sensor::Type, in insertion order
+    std::vector<Sensor*> sensorsByType[Sensor::TYPE_COUNT];
+    // Bitmap of contact sensor states
+    ContactStateTable contactStates;
+    // Status figures (per-type counts, primaries, reading ranges)
+    SensorAggregates aggregates;
+    // Ordered index: (sensor ID, sensor) sorted by ID
+    std::vector<SensorIdRange::Entry> idOrder;
+
+    // IDs whose membership changed, oldest first; the first one is change
+    // number 'membershipBase'. Dropped as a whole once the list is full
+    static constexpr size_t MEMBERSHIP_LOG_LIMIT = 4096;
+    std::vector<u_int32_t> membershipChanges;
+    u_int64_t membershipBase;
+
+    // Latest published version (swapped atomically) and the IDs changed
+    // since it was built
+    SensorTableVersion::Pin publishedVersion;
+    u_int64_t publishedMembership;  // getMembershipVersion() it was built at
+    std::unordered_set<u_int32_t> unpublishedIds;
+
+    // Deferred deletion of unlinked sensors (freed on commitLog)
+    EpochReclaimer reclaimer;
+
+    // Mutations not yet folded into the snapshot file
+    WriteAheadLog* log;
+
+    // Record slot of each sensor in our own file, changed sensors and
+    // freed slots, so saves rewrite only what changed
+    RecordSlotMap diskSlots;
+    size_t lastSaveBytes;
+    SensorFileFormat::Format fileFormat;
+
+    // Bounded in-memory history of recorded readings
+    ReadingHistory history;
+
+    // Background persistence (nullptr while checkpoints run inline)
+    Snapshotter* snapshotter;
+    size_t failuresSeen;     // Snapshot failures already handled
+    bool fullWriteNeeded;    // A failed snapshot left the file behind
+
+    // Change to persist, as logged by logMutation()
+    struct Mutation {
+        WriteAheadLog::Operation operation;
+        u_int32_t key;
+        Sensor* sensor;
+    };
+
+    // Write-ahead log helpers
+    void persistMutations(const std::vector<Mutation>& mutations,
+                          bool inBackground);
+    void logMutation(WriteAheadLog::Operation operation, u_int32_t key,
+                     const Sensor* sensor);
+    void applyLogEntry(const WriteAheadLog::Entry& entry);
+    bool isOwnFile(const char* filename) const;
+    void trackDiskSlot(WriteAheadLog::Operation operation, u_int32_t key,
+                       u_int32_t sensorId);
+    bool flushDirtySlots();
+    RecordSlotMap::Image captureDirtySlots();
+    bool startSnapshot();
+    bool tryCheckpoint();    // checkpoint() reporting failures to cerr
+    void waitForSnapshots();
+    void finishCheckpoint();
+    bool writeSnapshot(const char* filename, SensorFileFormat::Format format);
+    bool rewriteOwnFile();
+
+    // Index maintenance helpers
+    void appendSensor(Sensor* sensor, bool keepIdOrder = true);
+    void eraseSlot(size_t slot);
+    void rekeySlot(int32_t slot, u_int32_t newSensorId);
+    void compactSlots();
+    void validateBatch(const SensorBatch& batch) const;
+    void removeFromTypeList(Sensor* sensor);
+    void noteMembershipChange(u_int32_t sensorId);
+    void noteMembershipReset();
+    std::vector<SensorIdRange::Entry>::iterator findInIdOrder(
+        u_int32_t sensorId);
+    void refreshContactState(const Sensor* sensor);
+    int32_t slotOf(u_int32_t sensorId) const;
 };
 
 #endif // SENSORDATABASE_H
\ No newline at end of file
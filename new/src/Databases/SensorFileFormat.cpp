@@ -0,0 +1,173 @@
+#include "SensorFileFormat.h"
+#include "WriteAheadLog.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+namespace SensorFileFormat {
+
+    namespace {
+        // LEB128: 7 bits per byte, high bit set on all but the last byte
+        void putVarint(u_int32_t value, vector<char>& out) {
+            while (value >= 0x80) {
+                out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<char>(value));
+        }
+
+        bool getVarint(const unsigned char*& pos, const unsigned char* end,
+                       u_int32_t& value) {
+            value = 0;
+            for (int shift = 0; shift < 35 && pos < end; shift += 7) {
+                unsigned char byte = *pos++;
+                value |= static_cast<u_int32_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return true;
+                }
+            }
+            return false; // Truncated or over-long
+        }
+
+        // Zigzag keeps small negative readings (temperatures) short
+        u_int32_t zigzag(int value) {
+            return (static_cast<u_int32_t>(value) << 1) ^
+                   static_cast<u_int32_t>(value >> 31);
+        }
+
+        int unzigzag(u_int32_t value) {
+            return static_cast<int>((value >> 1) ^ (~(value & 1) + 1));
+        }
+    }
+
+    Format detect(const void* bytes, size_t size) {
+        u_int32_t magic = 0;
+        if (size >= sizeof(magic)) {
+            memcpy(&magic, bytes, sizeof(magic));
+        }
+        return (magic == MAGIC) ? COMPACT : FIXED_RECORDS;
+    }
+
+    const char* formatName(Format format) {
+        return (format == COMPACT) ? "compact" : "fixed records (legacy)";
+    }
+
+    size_t valueCount(u_int32_t sensorType) {
+        switch (sensorType) {
+            case Sensor::THERMAL_CAMERA:
+            case Sensor::RGB_CAMERA:
+                return Sensor::MAX_DATA_SIZE; // Whole frame
+            default:
+                return 1;                     // Single reading in data[0]
+        }
+    }
+
+    void encodeRecord(const SensorRecord& record, vector<char>& out) {
+        encodeValues(record.sensorId, record.sensorType, record.data, out);
+    }
+
+    void encodeValues(u_int32_t sensorId, u_int32_t sensorType,
+                      const int* values, vector<char>& out) {
+        putVarint(sensorId, out);
+        putVarint(sensorType, out);
+        size_t count = valueCount(sensorType);
+        for (size_t i = 0; i < count; i++) {
+            putVarint(zigzag(values[i]), out);
+        }
+    }
+
+    void encodeHeader(u_int32_t recordCount, vector<char>& out) {
+        Header header;
+        header.magic = MAGIC;
+        header.version = VERSION;
+        header.headerSize = sizeof(header);
+        header.recordCount = recordCount;
+
+        const char* headerBytes = reinterpret_cast<const char*>(&header);
+        out.insert(out.end(), headerBytes, headerBytes + sizeof(header));
+    }
+
+    bool decode(const void* bytes, size_t size,
+                vector<SensorRecord>& records) {
+        Header header;
+        if (size < sizeof(header)) {
+            return false;
+        }
+        memcpy(&header, bytes, sizeof(header));
+        if (header.magic != MAGIC || header.version > VERSION ||
+            header.headerSize < sizeof(header) || header.headerSize > size) {
+            cerr << "Warning: Unsupported sensor file version "
+                 << header.version << endl;
+            return false;
+        }
+
+        const unsigned char* pos =
+            static_cast<const unsigned char*>(bytes) + header.headerSize;
+        const unsigned char* end =
+            static_cast<const unsigned char*>(bytes) + size;
+
+        records.reserve(records.size() + header.recordCount);
+        for (u_int32_t n = 0; n < header.recordCount; n++) {
+            SensorRecord record;
+            memset(&record, 0, sizeof(record));
+            if (!getVarint(pos, end, record.sensorId) ||
+                !getVarint(pos, end, record.sensorType) ||
+                !SensorFactory::isValidRecord(record)) {
+                return false;
+            }
+
+            size_t values = valueCount(record.sensorType);
+            for (size_t i = 0; i < values; i++) {
+                u_int32_t encoded;
+                if (!getVarint(pos, end, encoded)) {
+                    return false;
+                }
+                record.data[i] = unzigzag(encoded);
+            }
+            records.push_back(record);
+        }
+        return true;
+    }
+
+    vector<char> encodeFile(const vector<Sensor*>& sensors) {
+        vector<char> buffer;
+        encodeHeader(static_cast<u_int32_t>(sensors.size()), buffer);
+        for (auto sensor : sensors) {
+            encodeValues(sensor->getSensorId(), sensor->getType(),
+                         sensor->getFullData(), buffer);
+        }
+        return buffer;
+    }
+
+    bool writeBuffer(const char* filename, const vector<char>& buffer) {
+        string tempName = string(filename) + ".tmp";
+        ofstream file(tempName.c_str(), ios::out | ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(buffer.data(), buffer.size());
+        file.close();
+        if (file.fail() || !WriteAheadLog::syncFile(tempName.c_str()) ||
+            rename(tempName.c_str(), filename) != 0) {
+            remove(tempName.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    bool writeFile(const char* filename, const vector<Sensor*>& sensors,
+                   size_t* bytesWritten) {
+        vector<char> buffer = encodeFile(sensors);
+        if (!writeBuffer(filename, buffer)) {
+            return false;
+        }
+        if (bytesWritten) {
+            *bytesWritten = buffer.size();
+        }
+        return true;
+    }
+}
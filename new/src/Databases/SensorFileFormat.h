@@ -0,0 +1,89 @@
+#ifndef SENSORFILEFORMAT_H
+#define SENSORFILEFORMAT_H
+
+#include <vector>
+#include <cstddef>
+#include <sys/types.h>
+#include "../Sensors/SensorFactory.h"
+
+/**
+ * @brief On-disk layouts of sensors.dat
+ *
+ * FIXED_RECORDS is the original layout: a bare array of 264-byte
+ * SensorRecord structs with no header. It supports in-place slot updates
+ * but scalar sensors waste 252 bytes of every record.
+ *
+ * COMPACT starts with a Header (magic "JVSF", version, record count)
+ * followed by variable-length records:
+ *
+ *     varint sensorId | varint sensorType | zigzag-varint values...
+ *
+ * Scalar sensors store one value, cameras store their whole frame
+ * (Sensor::MAX_DATA_SIZE values). A typical scalar record takes 5 bytes.
+ *
+ * Readers tell both layouts apart by the magic: a legacy file starts with
+ * a sensor ID or a tombstone, never with MAGIC.
+ */
+namespace SensorFileFormat {
+    enum Format {
+        FIXED_RECORDS = 0,  // Legacy headerless SensorRecord array
+        COMPACT = 1         // Header + variable-length records
+    };
+
+    constexpr u_int32_t MAGIC = 0x4653564A; // "JVSF"
+    constexpr u_int16_t VERSION = 1;
+
+    struct Header {
+        u_int32_t magic;
+        u_int16_t version;
+        u_int16_t headerSize;   // Lets later versions grow the header
+        u_int32_t recordCount;
+    };
+
+    // Layout of a file from its first bytes
+    Format detect(const void* bytes, size_t size);
+    const char* formatName(Format format);
+
+    // Number of data values stored for a sensor type
+    size_t valueCount(u_int32_t sensorType);
+
+    // Compact record encoding; encodeValues() reads valueCount(sensorType)
+    // values, so callers without a whole SensorRecord can use it
+    void encodeRecord(const SensorRecord& record, std::vector<char>& out);
+    void encodeValues(u_int32_t sensorId, u_int32_t sensorType,
+                      const int* values, std::vector<char>& out);
+
+    // Append the Header of a compact file holding 'recordCount' records
+    void encodeHeader(u_int32_t recordCount, std::vector<char>& out);
+
+    /**
+     * @brief Decode a whole compact file
+     *
+     * @param bytes File contents, starting with the Header
+     * @param size Size of the file contents
+     * @param records Receives the decoded records (unused values zeroed)
+     * @return false if the header is unsupported or the records end early;
+     *         the records decoded before the problem are kept
+     */
+    bool decode(const void* bytes, size_t size,
+                std::vector<SensorRecord>& records);
+
+    // Encode a whole compact file in memory
+    std::vector<char> encodeFile(const std::vector<Sensor*>& sensors);
+
+    // Replace a file with an encoded buffer (temp file + fsync + rename)
+    bool writeBuffer(const char* filename, const std::vector<char>& buffer);
+
+    /**
+     * @brief Write sensors to a compact file
+     *
+     * The file is written next to its destination and renamed over it once
+     * synced, so a crash never leaves a half-written snapshot behind.
+     *
+     * @return true on success; 'bytesWritten' receives the file size
+     */
+    bool writeFile(const char* filename, const std::vector<Sensor*>& sensors,
+                   size_t* bytesWritten = nullptr);
+}
+
+#endif // SENSORFILEFORMAT_H
@@ -0,0 +1,117 @@
+#include "SensorFileView.h"
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+SensorFileView::SensorFileView()
+    : mapping(nullptr), mappedSize(0), records(nullptr), count(0),
+      opened(false), fileFormat(SensorFileFormat::FIXED_RECORDS) {
+}
+
+SensorFileView::SensorFileView(const char* filename) : SensorFileView() {
+    open(filename);
+}
+
+SensorFileView::~SensorFileView() {
+    close();
+}
+
+/**
+ * @brief Map a sensor file read-only into memory
+ *
+ * @param filename Path of the binary sensor file
+ * @return true if the file could be mapped (an empty file gives an open
+ *         view with zero records), false if it could not be opened
+ */
+bool SensorFileView::open(const char* filename) {
+    close();
+
+    int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    mappedSize = static_cast<size_t>(info.st_size);
+    if (mappedSize > 0) {
+        mapping = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            cerr << "Warning: Could not map file '" << filename << "'" << endl;
+            mapping = nullptr;
+            mappedSize = 0;
+            ::close(fd);
+            return false;
+        }
+        // Records are consumed front to back
+        madvise(mapping, mappedSize, MADV_SEQUENTIAL);
+    }
+
+    // The mapping stays valid after closing the descriptor
+    ::close(fd);
+
+    fileFormat = SensorFileFormat::detect(mapping, mappedSize);
+    if (fileFormat == SensorFileFormat::COMPACT) {
+        if (!SensorFileFormat::decode(mapping, mappedSize, decoded)) {
+            cerr << "Warning: Sensor file '" << filename 
+                 << "' is truncated or corrupt, loaded " << decoded.size() 
+                 << " record(s)" << endl;
+        }
+        records = decoded.data();
+        count = decoded.size();
+    } else {
+        records = static_cast<const SensorRecord*>(mapping);
+        count = mappedSize / sizeof(SensorRecord);
+    }
+    opened = true;
+    return true;
+}
+
+void SensorFileView::close() {
+    if (mapping) {
+        munmap(mapping, mappedSize);
+    }
+    mapping = nullptr;
+    mappedSize = 0;
+    records = nullptr;
+    count = 0;
+    opened = false;
+    fileFormat = SensorFileFormat::FIXED_RECORDS;
+    decoded.clear();
+}
+
+const SensorRecord& SensorFileView::operator[](size_t index) const {
+    if (index >= count) {
+        throw out_of_range("Sensor record index " + to_string(index) +
+                           " out of range");
+    }
+    return records[index];
+}
+
+// Linear search over the mapped records, no allocation
+const SensorRecord* SensorFileView::findRecord(u_int32_t sensorId) const {
+    for (const SensorRecord* record = begin(); record != end(); ++record) {
+        if (record->sensorId == sensorId) {
+            return record;
+        }
+    }
+    return nullptr;
+}
+
+Sensor* SensorFileView::materialize(size_t index) const {
+    const SensorRecord& record = (*this)[index];
+    if (!SensorFactory::isValidRecord(record)) {
+        return nullptr;
+    }
+    return SensorFactory::recordToSensor(record);
+}
@@ -0,0 +1,60 @@
+#ifndef SENSORFILEVIEW_H
+#define SENSORFILEVIEW_H
+
+#include <cstddef>
+#include <vector>
+#include "../Sensors/SensorFactory.h"
+#include "SensorFileFormat.h"
+
+/**
+ * @brief Zero-copy, read-only view of a sensors.dat file
+ *
+ * Memory-maps the file and exposes its SensorRecord array in place, so
+ * read-only consumers (statistics, dashboards, export tools) can iterate
+ * the records without heap-allocating a Sensor per entry. A Sensor object
+ * is only built on demand through materialize(), e.g. when a sensor has to
+ * be mutated.
+ *
+ * Legacy fixed-record files are served straight from the mapping; compact
+ * files are decoded once into a SensorRecord array when opened.
+ *
+ * @note Trailing bytes that do not form a whole record are ignored
+ */
+class SensorFileView {
+public:
+    SensorFileView();
+    explicit SensorFileView(const char* filename);
+    ~SensorFileView();
+
+    // Non-copyable: the view owns the mapping
+    SensorFileView(const SensorFileView&) = delete;
+    SensorFileView& operator=(const SensorFileView&) = delete;
+
+    // Mapping management
+    bool open(const char* filename);
+    void close();
+    bool isOpen() const { return opened; }
+    SensorFileFormat::Format format() const { return fileFormat; }
+    size_t fileSize() const { return mappedSize; }
+
+    // Record access (valid while the view stays open)
+    size_t recordCount() const { return count; }
+    const SensorRecord* begin() const { return records; }
+    const SensorRecord* end() const { return records + count; }
+    const SensorRecord& operator[](size_t index) const;
+    const SensorRecord* findRecord(u_int32_t sensorId) const;
+
+    // Lazily build a Sensor from the record at 'index' (caller owns it)
+    Sensor* materialize(size_t index) const;
+
+private:
+    void* mapping;
+    size_t mappedSize;
+    const SensorRecord* records;
+    size_t count;
+    bool opened;
+    SensorFileFormat::Format fileFormat;
+    std::vector<SensorRecord> decoded; // Records of a compact file
+};
+
+#endif // SENSORFILEVIEW_H
@@ -0,0 +1,101 @@
+#include "SensorIdBitmap.h"
+#include "../Sensors/Sensor.h"
+
+using namespace std;
+
+namespace {
+    const size_t ID_SPACE = Sensor::MAX_SENSOR_ID - Sensor::MIN_SENSOR_ID + 1;
+}
+
+SensorIdBitmap::SensorIdBitmap() : usedBits((ID_SPACE + BITS - 1) / BITS, 0) {
+}
+
+void SensorIdBitmap::markUsed(u_int32_t sensorId) {
+    size_t bit = sensorId - Sensor::MIN_SENSOR_ID;
+    usedBits[bit / BITS] |= u_int64_t(1) << (bit % BITS);
+}
+
+void SensorIdBitmap::markFree(u_int32_t sensorId) {
+    size_t bit = sensorId - Sensor::MIN_SENSOR_ID;
+    usedBits[bit / BITS] &= ~(u_int64_t(1) << (bit % BITS));
+}
+
+bool SensorIdBitmap::isUsed(u_int32_t sensorId) const {
+    if (sensorId < Sensor::MIN_SENSOR_ID || sensorId > Sensor::MAX_SENSOR_ID) {
+        return false;
+    }
+    size_t bit = sensorId - Sensor::MIN_SENSOR_ID;
+    return (usedBits[bit / BITS] >> (bit % BITS)) & 1;
+}
+
+void SensorIdBitmap::clear() {
+    usedBits.assign(usedBits.size(), 0);
+}
+
+size_t SensorIdBitmap::countFree(u_int32_t first, u_int32_t last) const {
+    if (!clamp(first, last)) {
+        return 0;
+    }
+    size_t begin = first - Sensor::MIN_SENSOR_ID;
+    size_t end = last - Sensor::MIN_SENSOR_ID;
+    size_t free = 0;
+    for (size_t word = begin / BITS; word <= end / BITS; word++) {
+        free += __builtin_popcountll(freeBits(word, begin, end));
+    }
+    return free;
+}
+
+// Collect first, mark afterwards: a short range leaves the bitmap untouched
+bool SensorIdBitmap::allocate(u_int32_t first, u_int32_t last, size_t count,
+                              vector<u_int32_t>& ids) {
+    if (count == 0) {
+        return true;
+    }
+    if (!clamp(first, last)) {
+        return false;
+    }
+    size_t begin = first - Sensor::MIN_SENSOR_ID;
+    size_t end = last - Sensor::MIN_SENSOR_ID;
+    size_t start = ids.size();
+
+    for (size_t word = begin / BITS; word <= end / BITS; word++) {
+        u_int64_t bits = freeBits(word, begin, end);
+        while (bits != 0 && ids.size() - start < count) {
+            size_t bit = word * BITS + __builtin_ctzll(bits);
+            ids.push_back(static_cast<u_int32_t>(Sensor::MIN_SENSOR_ID + bit));
+            bits &= bits - 1;
+        }
+        if (ids.size() - start == count) {
+            for (size_t i = start; i < ids.size(); i++) {
+                markUsed(ids[i]);
+            }
+            return true;
+        }
+    }
+
+    ids.resize(start);
+    return false;
+}
+
+u_int64_t SensorIdBitmap::freeBits(size_t word, size_t first,
+                                   size_t last) const {
+    u_int64_t bits = ~usedBits[word];
+    if (word == first / BITS) {
+        bits &= ~u_int64_t(0) << (first % BITS);
+    }
+    if (word == last / BITS && last % BITS != BITS - 1) {
+        bits &= (u_int64_t(1) << (last % BITS + 1)) - 1;
+    }
+    return bits;
+}
+
+// Restrict a range to valid IDs; false if nothing is left
+bool SensorIdBitmap::clamp(u_int32_t& first, u_int32_t& last) {
+    if (first < Sensor::MIN_SENSOR_ID) {
+        first = Sensor::MIN_SENSOR_ID;
+    }
+    if (last > Sensor::MAX_SENSOR_ID) {
+        last = Sensor::MAX_SENSOR_ID;
+    }
+    return first <= last;
+}
@@ -0,0 +1,49 @@
+#ifndef SENSORIDBITMAP_H
+#define SENSORIDBITMAP_H
+
+#include <vector>
+#include <cstdint>
+#include <sys/types.h>
+
+/**
+ * @brief One bit per sensor ID (MIN_SENSOR_ID..MAX_SENSOR_ID), set while
+ * the ID is in use
+ *
+ * SensorDatabase keeps it in step with its ID index so free IDs are found
+ * 64 at a time: allocate() inverts each word of the requested range and
+ * walks its set bits, instead of probing findSensorById() ID by ID. The
+ * whole space is about 11 KB, so callers that need to reserve IDs across
+ * several requests copy it and allocate from the copy.
+ */
+class SensorIdBitmap {
+public:
+    SensorIdBitmap(); // Every ID free
+
+    void markUsed(u_int32_t sensorId);
+    void markFree(u_int32_t sensorId);
+    bool isUsed(u_int32_t sensorId) const;
+    void clear();
+
+    // Free IDs in [first, last] (clamped to the valid range)
+    size_t countFree(u_int32_t first, u_int32_t last) const;
+
+    /**
+     * @brief Take the 'count' lowest free IDs in [first, last]
+     *
+     * @param ids Receives the IDs, in ascending order (appended)
+     * @return false, taking nothing, if the range has fewer free IDs
+     */
+    bool allocate(u_int32_t first, u_int32_t last, size_t count,
+                  std::vector<u_int32_t>& ids);
+
+private:
+    static constexpr size_t BITS = 64;
+
+    // Free bits of word 'word' that fall inside [first, last] (bit offsets)
+    u_int64_t freeBits(size_t word, size_t first, size_t last) const;
+    static bool clamp(u_int32_t& first, u_int32_t& last);
+
+    std::vector<u_int64_t> usedBits;
+};
+
+#endif // SENSORIDBITMAP_H
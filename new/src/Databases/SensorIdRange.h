@@ -0,0 +1,50 @@
+#ifndef SENSORIDRANGE_H
+#define SENSORIDRANGE_H
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include "../Sensors/Sensor.h"
+
+/**
+ * @brief Read-only view over a run of SensorDatabase's ID-ordered index
+ *
+ * The index is an array of (sensor ID, sensor) pairs sorted by ID, so a
+ * range of IDs is one contiguous run found with two binary searches.
+ * Iterating it yields the sensors in ascending ID order.
+ *
+ * @note The view is invalidated by any add/remove/ID change on the database
+ */
+class SensorIdRange {
+public:
+    typedef std::pair<u_int32_t, Sensor*> Entry;
+    typedef std::vector<Entry>::const_iterator base_iterator;
+
+    class iterator {
+    public:
+        explicit iterator(base_iterator it) : it(it) {}
+
+        Sensor* operator*() const { return it->second; }
+        iterator& operator++() { ++it; return *this; }
+        bool operator==(const iterator& other) const { return it == other.it; }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+
+    private:
+        base_iterator it;
+    };
+
+    SensorIdRange(base_iterator first, base_iterator last)
+        : first(first), last(last) {}
+
+    iterator begin() const { return iterator(first); }
+    iterator end() const { return iterator(last); }
+    size_t size() const { return static_cast<size_t>(last - first); }
+    bool empty() const { return first == last; }
+    Sensor* operator[](size_t i) const { return (first + i)->second; }
+
+private:
+    base_iterator first;
+    base_iterator last;
+};
+
+#endif // SENSORIDRANGE_H
@@ -0,0 +1,115 @@
+#include "SensorManifest.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cctype>
+
+using namespace std;
+
+namespace {
+    const char* TYPE_NAMES[Sensor::TYPE_COUNT] = {
+        "HYGROMETER", "AIR_QUALITY", "LUX_METER", "TEMPERATURE",
+        "CONTACT", "THERMAL_CAMERA", "RGB_CAMERA"
+    };
+}
+
+SensorManifest SensorManifest::load(const char* filename) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Could not open manifest '" + string(filename) +
+                            "'");
+    }
+
+    SensorManifest manifest;
+    string line;
+    for (size_t lineNumber = 1; getline(file, line); lineNumber++) {
+        size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+
+        istringstream fields(line);
+        string typeToken;
+        if (!(fields >> typeToken)) {
+            continue; // Blank line
+        }
+
+        try {
+            Sensor::Type type = parseType(typeToken);
+            long long count = 0;
+            if (!(fields >> count) || count <= 0 ||
+                count > static_cast<long long>(Sensor::MAX_SENSOR_ID)) {
+                throw runtime_error("expected a sensor count");
+            }
+
+            long long firstId = 0;
+            long long lastId = 0;
+            if (fields >> firstId) {
+                if (!(fields >> lastId) ||
+                    firstId < static_cast<long long>(Sensor::MIN_SENSOR_ID) ||
+                    lastId > static_cast<long long>(Sensor::MAX_SENSOR_ID) ||
+                    firstId > lastId) {
+                    throw runtime_error("expected an ID range within " +
+                                        to_string(Sensor::MIN_SENSOR_ID) +
+                                        "-" + to_string(Sensor::MAX_SENSOR_ID));
+                }
+                string extra;
+                if (fields >> extra) {
+                    throw runtime_error("unexpected '" + extra + "'");
+                }
+                manifest.addEntry(type, static_cast<u_int32_t>(count),
+                                  static_cast<u_int32_t>(firstId),
+                                  static_cast<u_int32_t>(lastId));
+            } else {
+                fields.clear();
+                string extra;
+                if (fields >> extra) {
+                    throw runtime_error("unexpected '" + extra + "'");
+                }
+                manifest.addEntry(type, static_cast<u_int32_t>(count));
+            }
+        } catch (const runtime_error& e) {
+            throw runtime_error("Manifest line " + to_string(lineNumber) +
+                                ": " + e.what());
+        }
+    }
+    return manifest;
+}
+
+// Default range: the block of the type's primary sensor (hygrometers
+// 10000s, air quality 20000s, ...), primary ID excluded
+void SensorManifest::addEntry(Sensor::Type type, u_int32_t count) {
+    u_int32_t block = Sensor::MIN_SENSOR_ID * (static_cast<u_int32_t>(type) + 1);
+    addEntry(type, count, block + 1, block + 9999);
+}
+
+void SensorManifest::addEntry(Sensor::Type type, u_int32_t count,
+                              u_int32_t firstId, u_int32_t lastId) {
+    entries.push_back(Entry{type, count, firstId, lastId});
+}
+
+size_t SensorManifest::getSensorCount() const {
+    size_t total = 0;
+    for (const Entry& entry : entries) {
+        total += entry.count;
+    }
+    return total;
+}
+
+const char* SensorManifest::typeName(Sensor::Type type) {
+    return (type < Sensor::TYPE_COUNT) ? TYPE_NAMES[type] : "UNKNOWN";
+}
+
+// A type name (any case) or its number
+Sensor::Type SensorManifest::parseType(const string& token) {
+    string name;
+    for (char c : token) {
+        name += static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        if (name == TYPE_NAMES[type] || name == to_string(type)) {
+            return static_cast<Sensor::Type>(type);
+        }
+    }
+    throw runtime_error("unknown sensor type '" + token + "'");
+}
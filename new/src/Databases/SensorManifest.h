@@ -0,0 +1,57 @@
+#ifndef SENSORMANIFEST_H
+#define SENSORMANIFEST_H
+
+#include <vector>
+#include <string>
+#include "../Sensors/Sensor.h"
+
+/**
+ * @brief List of sensors to provision in bulk, read from a text file
+ *
+ * One group of sensors per line:
+ *
+ *     <type> <count> [<firstId> <lastId>]
+ *
+ * 'type' is a Sensor::Type name (TEMPERATURE, RGB_CAMERA, ...) or its
+ * number (0-6). Without a range the sensors go to their type's block of
+ * IDs, next to its primary sensor (TEMPERATURE: 40001-49999). Blank lines
+ * and anything after '#' are ignored. Example:
+ *
+ *     # Greenhouse wing B
+ *     TEMPERATURE 2000
+ *     CONTACT     400  80000 80999
+ *     6           12
+ *
+ * SensorDatabase::provision() picks the free IDs and adds every sensor in
+ * one batch.
+ */
+class SensorManifest {
+public:
+    struct Entry {
+        Sensor::Type type;
+        u_int32_t count;
+        u_int32_t firstId;  // Range the IDs are taken from
+        u_int32_t lastId;
+    };
+
+    // Parse a manifest file; throws runtime_error naming the bad line
+    static SensorManifest load(const char* filename);
+
+    void addEntry(Sensor::Type type, u_int32_t count);
+    void addEntry(Sensor::Type type, u_int32_t count, u_int32_t firstId,
+                  u_int32_t lastId);
+
+    const std::vector<Entry>& getEntries() const { return entries; }
+    size_t getSensorCount() const;
+    bool empty() const { return entries.empty(); }
+
+    // Type names as written in manifests
+    static const char* typeName(Sensor::Type type);
+
+private:
+    static Sensor::Type parseType(const std::string& token);
+
+    std::vector<Entry> entries;
+};
+
+#endif // SENSORMANIFEST_H
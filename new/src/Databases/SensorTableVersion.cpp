@@ -0,0 +1,128 @@
+#include "SensorTableVersion.h"
+#include <algorithm>
+
+using namespace std;
+
+// Out-of-line definition for the ODR-used constant
+constexpr size_t SensorTableVersion::BLOCK_SIZE;
+
+// With the same IDs as 'previous' the entries line up one to one with
+// 'idOrder', so only the blocks holding a changed ID are copied
+SensorTableVersion::Pin SensorTableVersion::publish(
+        const Pin& previous, const vector<SensorIdRange::Entry>& idOrder,
+        const unordered_set<u_int32_t>& changed,
+        const SensorAggregates& aggregates, bool sameIds) {
+    SensorTableVersion* next = new SensorTableVersion();
+    next->version = previous ? previous->version + 1 : 1;
+    next->aggregates = aggregates;
+    if (!previous || !sameIds) {
+        return rebuild(previous, idOrder, changed, next);
+    }
+
+    next->sensorCount = previous->sensorCount;
+    next->blocks = previous->blocks;
+    next->firstIds = previous->firstIds;
+
+    vector<Block*> copies(next->blocks.size(), nullptr); // Ours to change
+    for (u_int32_t sensorId : changed) {
+        size_t block = next->blockOf(sensorId);
+        if (block == next->blocks.size()) {
+            continue; // Not in the table
+        }
+        const Block& entries = *next->blocks[block];
+        auto entry = lower_bound(entries.begin(), entries.end(), sensorId,
+                                 [](const Entry& e, u_int32_t id) {
+                                     return e.first < id;
+                                 });
+        if (entry == entries.end() || entry->first != sensorId) {
+            continue;
+        }
+        size_t offset = static_cast<size_t>(entry - entries.begin());
+        if (!copies[block]) {
+            copies[block] = new Block(entries);
+            next->blocks[block] = shared_ptr<const Block>(copies[block]);
+        }
+        const Sensor* live = idOrder[block * BLOCK_SIZE + offset].second;
+        (*copies[block])[offset].second =
+            shared_ptr<const Sensor>(live->clone());
+    }
+    return Pin(next);
+}
+
+// Walk the live table and the previous version together (both sorted by
+// ID), reusing the copy of every sensor that did not change
+SensorTableVersion::Pin SensorTableVersion::rebuild(
+        const Pin& previous, const vector<SensorIdRange::Entry>& idOrder,
+        const unordered_set<u_int32_t>& changed, SensorTableVersion* next) {
+    next->sensorCount = idOrder.size();
+    next->blocks.reserve((idOrder.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    next->firstIds.reserve(next->blocks.capacity());
+
+    size_t reusedBlock = 0;
+    size_t reused = 0;
+    Block* block = nullptr;
+    for (const SensorIdRange::Entry& live : idOrder) {
+        if (!block || block->size() == BLOCK_SIZE) {
+            block = new Block();
+            block->reserve(BLOCK_SIZE);
+            next->blocks.push_back(shared_ptr<const Block>(block));
+            next->firstIds.push_back(live.first);
+        }
+
+        // Advance through the previous version to the first ID >= live
+        const Entry* old = nullptr;
+        while (previous && reusedBlock < previous->blocks.size()) {
+            const Block& entries = *previous->blocks[reusedBlock];
+            if (reused == entries.size()) {
+                reusedBlock++;
+                reused = 0;
+                continue;
+            }
+            if (entries[reused].first < live.first) {
+                reused++;
+                continue;
+            }
+            old = &entries[reused];
+            break;
+        }
+
+        bool unchanged = old && old->first == live.first &&
+                         changed.count(live.first) == 0;
+        if (unchanged) {
+            block->push_back(*old);
+        } else {
+            block->push_back(Entry(live.first,
+                shared_ptr<const Sensor>(live.second->clone())));
+        }
+    }
+    return Pin(next);
+}
+
+// Block that would hold 'sensorId', blocks.size() if none
+size_t SensorTableVersion::blockOf(u_int32_t sensorId) const {
+    auto after = upper_bound(firstIds.begin(), firstIds.end(), sensorId);
+    if (after == firstIds.begin()) {
+        return blocks.size();
+    }
+    return static_cast<size_t>(after - firstIds.begin()) - 1;
+}
+
+const Sensor* SensorTableVersion::findSensorById(u_int32_t sensorId) const {
+    size_t block = blockOf(sensorId);
+    if (block == blocks.size()) {
+        return nullptr;
+    }
+    const Block& entries = *blocks[block];
+    auto it = lower_bound(entries.begin(), entries.end(), sensorId,
+                          [](const Entry& entry, u_int32_t id) {
+                              return entry.first < id;
+                          });
+    if (it == entries.end() || it->first != sensorId) {
+        return nullptr;
+    }
+    return it->second.get();
+}
+
+size_t SensorTableVersion::countSensorsOfType(Sensor::Type type) const {
+    return (type < Sensor::TYPE_COUNT) ? aggregates.forType(type).sensors : 0;
+}
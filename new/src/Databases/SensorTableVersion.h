@@ -0,0 +1,77 @@
+#ifndef SENSORTABLEVERSION_H
+#define SENSORTABLEVERSION_H
+
+#include <vector>
+#include <memory>
+#include <unordered_set>
+#include "../Sensors/Sensor.h"
+#include "SensorIdRange.h"
+#include "SensorAggregates.h"
+
+/**
+ * @brief Immutable copy of the sensor table, for readers on any thread
+ *
+ * SensorDatabase publishes a new version after each group commit; readers
+ * pin the current one (a shared_ptr) and keep reading it while writers go
+ * on mutating the live table, without taking any lock of the database. A
+ * version is freed when its last pin is dropped.
+ *
+ * Versions share the copies of unchanged sensors: publishing clones only
+ * the sensors changed since the previous version and takes every other
+ * copy from it. The copies are held in blocks of BLOCK_SIZE; when only
+ * readings changed (same IDs as the previous version) the new version
+ * shares every block without a changed sensor, so the cost is one
+ * pointer per block plus one block per change. Sensors added, removed or
+ * re-keyed rebuild the block list: one pointer per sensor.
+ */
+class SensorTableVersion {
+public:
+    typedef std::shared_ptr<const SensorTableVersion> Pin;
+
+    /**
+     * @brief Build the version that follows 'previous'
+     *
+     * @param previous Last published version (nullptr clones everything)
+     * @param idOrder Live sensors in ascending ID order
+     * @param changed IDs whose sensors must be cloned again
+     * @param aggregates Live status figures, copied into the version
+     * @param sameIds Whether 'idOrder' holds exactly the IDs of 'previous'
+     */
+    static Pin publish(const Pin& previous,
+                       const std::vector<SensorIdRange::Entry>& idOrder,
+                       const std::unordered_set<u_int32_t>& changed,
+                       const SensorAggregates& aggregates, bool sameIds);
+
+    u_int64_t getVersion() const { return version; }
+
+    // Sensors in ascending ID order
+    size_t getSensorCount() const { return sensorCount; }
+    const Sensor* getSensor(size_t i) const {
+        return (*blocks[i / BLOCK_SIZE])[i % BLOCK_SIZE].second.get();
+    }
+    const Sensor* findSensorById(u_int32_t sensorId) const;
+    size_t countSensorsOfType(Sensor::Type type) const;
+    const SensorAggregates& getAggregates() const { return aggregates; }
+
+private:
+    static constexpr size_t BLOCK_SIZE = 256;  // Entries per block
+
+    typedef std::pair<u_int32_t, std::shared_ptr<const Sensor>> Entry;
+    typedef std::vector<Entry> Block;  // BLOCK_SIZE entries, but the last
+
+    SensorTableVersion() : version(0), sensorCount(0) {}
+
+    static Pin rebuild(const Pin& previous,
+                       const std::vector<SensorIdRange::Entry>& idOrder,
+                       const std::unordered_set<u_int32_t>& changed,
+                       SensorTableVersion* next);
+    size_t blockOf(u_int32_t sensorId) const;
+
+    u_int64_t version;
+    size_t sensorCount;
+    std::vector<std::shared_ptr<const Block>> blocks;
+    std::vector<u_int32_t> firstIds;   // ID of each block's first entry
+    SensorAggregates aggregates;
+};
+
+#endif // SENSORTABLEVERSION_H
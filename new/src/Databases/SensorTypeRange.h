@@ -0,0 +1,46 @@
+#ifndef SENSORTYPERANGE_H
+#define SENSORTYPERANGE_H
+
+#include <vector>
+#include <cstddef>
+#include "../Sensors/Sensor.h"
+
+/**
+ * @brief Read-only view over the sensors of a single concrete type
+ *
+ * Wraps one of the per-type membership lists kept by SensorDatabase. Every
+ * element is known to be a T, so it is returned with a static_cast instead
+ * of the dynamic_cast needed when filtering the full sensor vector.
+ *
+ * @note The view is invalidated by any add/remove on the database
+ */
+template <typename T>
+class SensorTypeRange {
+public:
+    class iterator {
+    public:
+        explicit iterator(std::vector<Sensor*>::const_iterator it) : it(it) {}
+
+        T* operator*() const { return static_cast<T*>(*it); }
+        iterator& operator++() { ++it; return *this; }
+        bool operator==(const iterator& other) const { return it == other.it; }
+        bool operator!=(const iterator& other) const { return it != other.it; }
+
+    private:
+        std::vector<Sensor*>::const_iterator it;
+    };
+
+    explicit SensorTypeRange(const std::vector<Sensor*>& members)
+        : members(&members) {}
+
+    iterator begin() const { return iterator(members->begin()); }
+    iterator end() const { return iterator(members->end()); }
+    size_t size() const { return members->size(); }
+    bool empty() const { return members->empty(); }
+    T* operator[](size_t i) const { return static_cast<T*>((*members)[i]); }
+
+private:
+    const std::vector<Sensor*>* members;
+};
+
+#endif // SENSORTYPERANGE_H
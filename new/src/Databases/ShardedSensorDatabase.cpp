@@ -0,0 +1,297 @@
+#include <iostream>
+#include <cstring>
+#include <algorithm>
+#include "ShardedSensorDatabase.h"
+#include "SensorFileView.h"
+#include "SensorFileFormat.h"
+#include "WriteAheadLog.h"
+#include "../Sensors/SensorFactory.h"
+
+using namespace std;
+
+// Out-of-line definition for the ODR-used constant
+constexpr size_t ShardedSensorDatabase::DEFAULT_SHARD_COUNT;
+
+namespace {
+    // Scoped pthread_rwlock_t holders
+    class SharedLock {
+    public:
+        explicit SharedLock(pthread_rwlock_t& lock) : lock(lock) {
+            pthread_rwlock_rdlock(&lock);
+        }
+        ~SharedLock() { pthread_rwlock_unlock(&lock); }
+    private:
+        pthread_rwlock_t& lock;
+    };
+
+    class ExclusiveLock {
+    public:
+        explicit ExclusiveLock(pthread_rwlock_t& lock) : lock(lock) {
+            pthread_rwlock_wrlock(&lock);
+        }
+        ~ExclusiveLock() { pthread_rwlock_unlock(&lock); }
+    private:
+        pthread_rwlock_t& lock;
+    };
+}
+
+// Constructor
+ShardedSensorDatabase::ShardedSensorDatabase(const char* inputFilename,
+                                             size_t shardCount) {
+    if (shardCount == 0) {
+        throw invalid_argument("Shard count must be at least 1");
+    }
+
+    setFilename(inputFilename);
+
+    // Changes logged by SensorDatabase are not replayed here, and our next
+    // save would drop them
+    if (WriteAheadLog::hasPendingChanges(this->filename)) {
+        throw runtime_error("'" + string(this->filename) + "' has logged "
+                            "changes: open it with SensorDatabase first");
+    }
+
+    shards.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; i++) {
+        Shard* shard = new Shard;
+        shard->modified = false;
+        if (pthread_rwlock_init(&shard->lock, nullptr) != 0) {
+            delete shard;
+            for (auto created : shards) {
+                pthread_rwlock_destroy(&created->lock);
+                delete created;
+            }
+            throw runtime_error("Could not initialize shard lock");
+        }
+        shards.push_back(shard);
+    }
+
+    loadFromFile(this->filename);
+    for (auto shard : shards) {
+        shard->modified = false; // Only what was loaded so far
+    }
+}
+
+// Destructor
+ShardedSensorDatabase::~ShardedSensorDatabase() {
+    if (isModified()) {
+        try {
+            saveToFile(this->filename);
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << endl;
+        }
+    }
+
+    for (auto shard : shards) {
+        for (auto& entry : shard->sensors) {
+            delete entry.second;
+        }
+        pthread_rwlock_destroy(&shard->lock);
+        delete shard;
+    }
+    SensorFactory::releaseUnusedMemory();
+}
+
+bool ShardedSensorDatabase::loadFromFile(const char* filename) {
+    SensorFileView view;
+    if (!view.open(filename)) {
+        cerr << "Warning: Could not open file '"
+            << filename << "' for reading." << endl;
+        return false;
+    }
+
+    for (const SensorRecord& record : view) {
+        if (SensorFactory::isTombstone(record)) {
+            continue;
+        }
+        if (!SensorFactory::isValidRecord(record)) {
+            break;
+        }
+
+        Sensor* sensor = SensorFactory::recordToSensor(record);
+        if (sensor == nullptr) {
+            break;
+        }
+        if (!insert(sensor)) {
+            delete sensor; // Already loaded
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Write every sensor to a compact file
+ *
+ * All shards are read-locked while the records are encoded in memory, so
+ * the file is a consistent snapshot; the write itself happens unlocked.
+ *
+ * @throws runtime_error if the file cannot be written
+ */
+bool ShardedSensorDatabase::saveToFile(const char* filename) {
+    // Always locked in index order: writers hold a single shard
+    for (auto shard : shards) {
+        pthread_rwlock_rdlock(&shard->lock);
+    }
+
+    vector<Sensor*> sensors;
+    for (auto shard : shards) {
+        for (auto& entry : shard->sensors) {
+            sensors.push_back(entry.second);
+        }
+    }
+    sort(sensors.begin(), sensors.end(),
+         [](const Sensor* a, const Sensor* b) { return *a < *b; });
+    vector<char> buffer = SensorFileFormat::encodeFile(sensors);
+
+    for (auto shard : shards) {
+        pthread_rwlock_unlock(&shard->lock);
+    }
+
+    if (!SensorFileFormat::writeBuffer(filename, buffer)) {
+        throw runtime_error("Could not open file for writing.");
+    }
+    return true;
+}
+
+// Drop every non-primary sensor and write the primary ones back
+bool ShardedSensorDatabase::clearFile(const char* filename) {
+    for (auto shard : shards) {
+        ExclusiveLock lock(shard->lock);
+        for (auto it = shard->sensors.begin(); it != shard->sensors.end(); ) {
+            if (it->second->isPrimarySensor()) {
+                ++it;
+            } else {
+                delete it->second;
+                it = shard->sensors.erase(it);
+                shard->modified = true;
+            }
+        }
+    }
+    SensorFactory::releaseUnusedMemory(); // Slabs emptied by the removals
+    return saveToFile(filename);
+}
+
+bool ShardedSensorDatabase::addSensor(Sensor* sensor) {
+    if (!sensor) {
+        throw invalid_argument("Cannot add null sensor");
+    }
+
+    // Validate sensor ID range
+    if (sensor->getSensorId() < Sensor::MIN_SENSOR_ID ||
+        sensor->getSensorId() > Sensor::MAX_SENSOR_ID) {
+        throw invalid_argument("Sensor ID must be between " +
+                              to_string(Sensor::MIN_SENSOR_ID) + " and " +
+                              to_string(Sensor::MAX_SENSOR_ID));
+    }
+
+    return insert(sensor); // false if the ID already exists
+}
+
+/**
+ * @brief Remove and delete a stored sensor
+ *
+ * @param sensorId ID of the sensor to remove
+ * @return true if removed, false if no sensor has that ID
+ * @throws runtime_error if the sensor is a primary sensor
+ */
+bool ShardedSensorDatabase::removeSensor(u_int32_t sensorId) {
+    Sensor* removed = nullptr;
+    {
+        Shard& shard = shardFor(sensorId);
+        ExclusiveLock lock(shard.lock);
+        auto it = shard.sensors.find(sensorId);
+        if (it == shard.sensors.end()) {
+            return false;
+        }
+        if (it->second->isPrimarySensor()) {
+            throw runtime_error("Cannot remove primary sensor with ID " +
+                               to_string(sensorId));
+        }
+        removed = it->second;
+        shard.sensors.erase(it);
+        shard.modified = true;
+    }
+    delete removed; // Unreachable now: delete outside the lock
+    return true;
+}
+
+bool ShardedSensorDatabase::containsSensor(u_int32_t sensorId) const {
+    Shard& shard = shardFor(sensorId);
+    SharedLock lock(shard.lock);
+    return shard.sensors.count(sensorId) != 0;
+}
+
+bool ShardedSensorDatabase::readSensor(u_int32_t sensorId,
+                                       const Reader& reader) const {
+    Shard& shard = shardFor(sensorId);
+    SharedLock lock(shard.lock);
+    auto it = shard.sensors.find(sensorId);
+    if (it == shard.sensors.end()) {
+        return false;
+    }
+    reader(*it->second);
+    return true;
+}
+
+// The writer must not change the sensor ID: remove and re-add instead
+bool ShardedSensorDatabase::updateSensor(u_int32_t sensorId,
+                                         const Writer& writer) {
+    Shard& shard = shardFor(sensorId);
+    ExclusiveLock lock(shard.lock);
+    auto it = shard.sensors.find(sensorId);
+    if (it == shard.sensors.end()) {
+        return false;
+    }
+    writer(*it->second);
+    shard.modified = true;
+    return true;
+}
+
+bool ShardedSensorDatabase::collectData(u_int32_t sensorId) {
+    return updateSensor(sensorId, [](Sensor& sensor) { sensor.collectData(); });
+}
+
+void ShardedSensorDatabase::forEachSensor(const Reader& reader) const {
+    for (auto shard : shards) {
+        SharedLock lock(shard->lock);
+        for (auto& entry : shard->sensors) {
+            reader(*entry.second);
+        }
+    }
+}
+
+size_t ShardedSensorDatabase::getSensorCount() const {
+    size_t count = 0;
+    for (auto shard : shards) {
+        SharedLock lock(shard->lock);
+        count += shard->sensors.size();
+    }
+    return count;
+}
+
+// Consecutive IDs land on consecutive shards
+ShardedSensorDatabase::Shard& ShardedSensorDatabase::shardFor(
+        u_int32_t sensorId) const {
+    return *shards[sensorId % shards.size()];
+}
+
+bool ShardedSensorDatabase::insert(Sensor* sensor) {
+    Shard& shard = shardFor(sensor->getSensorId());
+    ExclusiveLock lock(shard.lock);
+    u_int32_t sensorId = sensor->getSensorId();
+    if (!shard.sensors.insert(make_pair(sensorId, sensor)).second) {
+        return false;
+    }
+    shard.modified = true;
+    return true;
+}
+
+bool ShardedSensorDatabase::isModified() const {
+    for (auto shard : shards) {
+        SharedLock lock(shard->lock);
+        if (shard->modified) {
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,88 @@
+#ifndef SHARDEDSENSORDATABASE_H
+#define SHARDEDSENSORDATABASE_H
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+#include <pthread.h>
+#include "../Sensors/Sensor.h"
+#include "Database.h"
+
+/**
+ * @brief Sensor store that many threads can use at once
+ *
+ * Sensors are partitioned by ID into shards, each with its own
+ * reader/writer lock. Collectors updating readings on different shards
+ * never wait for each other, and admin operations (add/remove) only block
+ * the one shard they touch.
+ *
+ * Stored sensors are never handed out as raw pointers: callers reach them
+ * through callbacks that run while their shard is locked (shared for
+ * readSensor, exclusive for updateSensor), so a sensor cannot be deleted
+ * under a reader.
+ *
+ * Snapshots are written in the compact format; both formats are loaded.
+ * Unlike SensorDatabase there is no write-ahead log: changes reach the
+ * disk on saveToFile() and on destruction (only if there were any). A
+ * file whose SensorDatabase log still holds changes is refused, since
+ * saving over it would lose them. Benchmark use only: not part of the
+ * application build.
+ *
+ * Usage (collector thread):
+ *     db.updateSensor(id, [&](Sensor& s) { s.setSingleData(reading); });
+ */
+class ShardedSensorDatabase : public Database {
+public:
+    static constexpr size_t DEFAULT_SHARD_COUNT = 64;
+
+    typedef std::function<void(const Sensor&)> Reader;
+    typedef std::function<void(Sensor&)> Writer;
+
+    explicit ShardedSensorDatabase(const char* filename = "sensors.dat",
+                                   size_t shardCount = DEFAULT_SHARD_COUNT);
+    ~ShardedSensorDatabase();
+
+    // Non-copyable: owns the sensors and the locks
+    ShardedSensorDatabase(const ShardedSensorDatabase&) = delete;
+    ShardedSensorDatabase& operator=(const ShardedSensorDatabase&) = delete;
+
+    // File Management (inherited from Database)
+    bool loadFromFile(const char* filename) override;
+    bool saveToFile(const char* filename) override;
+    bool clearFile(const char* filename) override;
+
+    // Sensor Management (the database owns added sensors)
+    bool addSensor(Sensor* sensor);
+    bool removeSensor(u_int32_t sensorId);
+    bool containsSensor(u_int32_t sensorId) const;
+
+    // Per-sensor access; false if the ID is not stored
+    bool readSensor(u_int32_t sensorId, const Reader& reader) const;
+    bool updateSensor(u_int32_t sensorId, const Writer& writer);
+    // Safe next to collectData() of other shards: the masters' coordinator
+    // state that cameras read is atomic (SensorCoordinator)
+    bool collectData(u_int32_t sensorId);
+
+    // Visit every sensor, one shard at a time (not a point-in-time view)
+    void forEachSensor(const Reader& reader) const;
+
+    // Statistics
+    size_t getSensorCount() const;
+    size_t getShardCount() const { return shards.size(); }
+
+private:
+    struct Shard {
+        mutable pthread_rwlock_t lock;
+        std::unordered_map<u_int32_t, Sensor*> sensors;
+        bool modified;    // Changed since loaded
+        char padding[64]; // Keeps the next shard's lock off our cache line
+    };
+
+    Shard& shardFor(u_int32_t sensorId) const;
+    bool insert(Sensor* sensor);
+    bool isModified() const;
+
+    std::vector<Shard*> shards;
+};
+
+#endif // SHARDEDSENSORDATABASE_H
@@ -0,0 +1,121 @@
+#include "Snapshotter.h"
+#include <iostream>
+
+using namespace std;
+
+// Out-of-line definition for the ODR-used constant
+constexpr unsigned Snapshotter::DEFAULT_CADENCE_SECONDS;
+
+Snapshotter::Snapshotter(unsigned cadenceSeconds)
+    : busy(false), stopping(false), snapshotQueued(false),
+      cadence(cadenceSeconds), lastCapture(chrono::steady_clock::now()) {
+    stats.completed = 0;
+    stats.failed = 0;
+    stats.lastDurationMs = 0.0;
+    stats.lastBytes = 0;
+    stats.totalBytes = 0;
+    worker = thread(&Snapshotter::run, this);
+}
+
+Snapshotter::~Snapshotter() {
+    {
+        lock_guard<std::mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void Snapshotter::setCadence(unsigned seconds) {
+    lock_guard<std::mutex> lock(stateMutex);
+    cadence = chrono::seconds(seconds);
+}
+
+unsigned Snapshotter::getCadence() const {
+    lock_guard<std::mutex> lock(stateMutex);
+    return static_cast<unsigned>(cadence.count());
+}
+
+bool Snapshotter::isDue() const {
+    lock_guard<std::mutex> lock(stateMutex);
+    return !snapshotQueued &&
+           chrono::steady_clock::now() - lastCapture >= cadence;
+}
+
+bool Snapshotter::snapshotPending() const {
+    lock_guard<std::mutex> lock(stateMutex);
+    return snapshotQueued;
+}
+
+void Snapshotter::submitSnapshot(const SnapshotJob& job) {
+    {
+        lock_guard<std::mutex> lock(stateMutex);
+        snapshotQueued = true;
+        lastCapture = chrono::steady_clock::now();
+    }
+
+    submit([this, job]() {
+        auto start = chrono::steady_clock::now();
+        size_t bytes = 0;
+        bool written = job(bytes);
+        double elapsed = chrono::duration<double, milli>(
+            chrono::steady_clock::now() - start).count();
+
+        lock_guard<std::mutex> lock(stateMutex);
+        snapshotQueued = false;
+        if (!written) {
+            stats.failed++;
+            return;
+        }
+        stats.completed++;
+        stats.lastDurationMs = elapsed;
+        stats.lastBytes = bytes;
+        stats.totalBytes += bytes;
+    });
+}
+
+void Snapshotter::submit(const Task& task) {
+    {
+        lock_guard<std::mutex> lock(stateMutex);
+        queue.push_back(task);
+    }
+    wake.notify_one();
+}
+
+void Snapshotter::drain() {
+    unique_lock<std::mutex> lock(stateMutex);
+    idle.wait(lock, [this]() { return queue.empty() && !busy; });
+}
+
+Snapshotter::Stats Snapshotter::getStats() const {
+    lock_guard<std::mutex> lock(stateMutex);
+    return stats;
+}
+
+void Snapshotter::run() {
+    unique_lock<std::mutex> lock(stateMutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            break; // Stopping with nothing left to write
+        }
+
+        Task task = queue.front();
+        queue.pop_front();
+        busy = true;
+
+        lock.unlock();
+        try {
+            task();
+        } catch (const exception& e) {
+            cerr << "Error: Background persistence failed: " << e.what()
+                 << endl;
+        }
+        lock.lock();
+
+        busy = false;
+        if (queue.empty()) {
+            idle.notify_all();
+        }
+    }
+}
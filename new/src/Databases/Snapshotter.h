@@ -0,0 +1,81 @@
+#ifndef SNAPSHOTTER_H
+#define SNAPSHOTTER_H
+
+#include <deque>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @brief Background persistence thread
+ *
+ * Runs disk work handed over by a database on a single worker thread, in
+ * submission order. The owner captures a point-in-time image of its state
+ * (a memory copy) and submits a job that writes it out, so callers on the
+ * collection and alarm paths never wait for write() or fsync().
+ *
+ * Snapshot jobs are paced by a cadence: isDue() turns true once the
+ * cadence has elapsed since the last capture and no snapshot is queued.
+ * Plain tasks (e.g. write-ahead log group commits) share the same queue so
+ * their order relative to snapshots is preserved.
+ */
+class Snapshotter {
+public:
+    static constexpr unsigned DEFAULT_CADENCE_SECONDS = 30;
+
+    // Writes a captured image, reports the bytes written, false on error
+    typedef std::function<bool(size_t& bytesWritten)> SnapshotJob;
+    typedef std::function<void()> Task;
+
+    struct Stats {
+        size_t completed;        // Snapshots written
+        size_t failed;           // Snapshots that hit an I/O error
+        double lastDurationMs;   // Time spent writing the last snapshot
+        size_t lastBytes;        // Bytes written by the last snapshot
+        size_t totalBytes;       // Bytes written by all snapshots
+    };
+
+    explicit Snapshotter(unsigned cadenceSeconds = DEFAULT_CADENCE_SECONDS);
+    ~Snapshotter(); // Finishes the queued work, then joins the thread
+
+    // Non-copyable: owns a thread
+    Snapshotter(const Snapshotter&) = delete;
+    Snapshotter& operator=(const Snapshotter&) = delete;
+
+    // Cadence between captures
+    void setCadence(unsigned seconds);
+    unsigned getCadence() const;
+    bool isDue() const;
+    bool snapshotPending() const;
+
+    // Queue work for the background thread
+    void submitSnapshot(const SnapshotJob& job);
+    void submit(const Task& task);
+
+    // Block until every queued job has finished
+    void drain();
+
+    Stats getStats() const;
+
+private:
+    void run();
+
+    mutable std::mutex stateMutex;
+    std::condition_variable wake;   // Work queued or stopping
+    std::condition_variable idle;   // Queue drained
+    std::deque<Task> queue;
+    bool busy;
+    bool stopping;
+    bool snapshotQueued;
+
+    std::chrono::seconds cadence;
+    std::chrono::steady_clock::time_point lastCapture;
+    Stats stats;
+
+    std::thread worker;             // Started last, joined first
+};
+
+#endif // SNAPSHOTTER_H
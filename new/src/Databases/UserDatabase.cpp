@@ -17,25 +17,27 @@ class UserFactory;
 using namespace std;
 
 // Constructor
-UserDatabase::UserDatabase(const char* inputFilename) {
-    // Copy the input filename to the member variable with bounds checking
-    strncpy(this->filename, inputFilename, MAX_STR - 1);
-    this->filename[MAX_STR - 1] = '\0'; // Ensure null termination
-    
-    // Make sure the filename has .dat extension
-    size_t len = strlen(this->filename);
-    if (len < 4 || strcmp(this->filename + len - 4, ".dat") != 0) {
-        // If filename doesn't end with .dat, append it (if there's space)
-        if (len + 4 < MAX_STR) {
-            strcat(this->filename, ".dat");
-        } else {
-            cerr << "Warning: Filename too long to append .dat extension\n";
-        }
-    }
+UserDatabase::UserDatabase(const char* inputFilename) 
+    : roleCounts(), log(nullptr),
+      diskSlots(User::MIN_USER_NUMBER, User::MAX_USER_NUMBER, 
+                sizeof(UserRecord)),
+      lastSaveBytes(0) {
+    setFilename(inputFilename);
 
     // First, load existing users from file if it exists
     loadFromFile(this->filename);
 
+    // Then apply the mutations logged after the last checkpoint
+    log = new WriteAheadLog(WriteAheadLog::logPathFor(this->filename), 
+                            sizeof(UserRecord));
+    size_t replayed = log->replay([this](const WriteAheadLog::Entry& entry) {
+        applyLogEntry(entry);
+    });
+    if (replayed > 0) {
+        cout << "Recovered " << replayed << " logged user change(s)" << endl;
+        checkpoint();
+    }
+
     // After loading, check if default admin exists
     u_int32_t adminNumber = 10000;
     const char* NIF = "00000000";
@@ -44,19 +46,22 @@ UserDatabase::UserDatabase(const char* inputFilename) {
     // Only create admin if doesn't exists
     if (findUserByNumber(adminNumber) == nullptr) {
         Admin* defaultAdmin = new Admin(adminNumber, NIF, pwd, User::ADMIN);
-        this->users.insert(defaultAdmin);
+        insertUser(defaultAdmin);
+        diskSlots.markDirty(adminNumber);
     }
 }
 
 // Destructor
 UserDatabase::~UserDatabase() {
-    // Save to file before destroying
+    // Save to file before destroying (checkpoints the log)
     saveToFile(this->filename);
+    delete log;
     
     // Free memory for all users
     for (auto user : users) {
         delete user;
     }
+    UserFactory::releaseUnusedMemory();
 }
 
 bool UserDatabase::loadFromFile(const char* filename) {
@@ -68,22 +73,74 @@ bool UserDatabase::loadFromFile(const char* filename) {
         return false;
     }
 
-    // Read records until end of file
-    User* user = nullptr;
-    while ((user = UserFactory::readUserFromFile(file)) != nullptr) {
-        // Try to add the user (set will handle duplicates)
-        if (!users.insert(user).second) {
+    // Records of our own file are remembered by slot for in-place saves;
+    // users taken from any other file are new to it
+    bool ownFile = isOwnFile(filename);
+
+    // Read records until end of file or the first invalid one
+    UserRecord record;
+    u_int32_t slot = 0;
+    for (; file.read(reinterpret_cast<char*>(&record), sizeof(UserRecord)); 
+         slot++) {
+        if (UserFactory::isTombstone(record)) {
+            if (ownFile) {
+                diskSlots.freeSlot(slot);
+            }
+            continue;
+        }
+        if (!UserFactory::isValidRecord(record)) {
+            break;
+        }
+        
+        if (findUserByNumber(record.userNumber) != nullptr) {
+            if (ownFile) {
+                if (diskSlots.slotOf(record.userNumber) == RecordSlotMap::NO_SLOT) {
+                    diskSlots.assign(record.userNumber, slot);
+                } else if (diskSlots.slotOf(record.userNumber) != 
+                           static_cast<int32_t>(slot)) {
+                    diskSlots.freeSlot(slot); // Stale copy
+                }
+                continue; // Reloading our own file
+            }
             cerr << "Warning: Duplicate user with number " 
-                 << user->getuserNumber() << " ignored" << endl;
-            delete user; // Clean up if not inserted
+                 << record.userNumber << " ignored" << endl;
+            continue;
+        }
+        
+        User* user = UserFactory::recordToUser(record);
+        if (user == nullptr) {
+            break;
+        }
+        insertUser(user);
+        if (ownFile) {
+            diskSlots.assign(record.userNumber, slot);
+        } else {
+            diskSlots.markDirty(record.userNumber);
         }
     }
+    
+    // Anything after the first invalid record is overwritten on save
+    if (ownFile && slot > diskSlots.slotCount()) {
+        diskSlots.setSlotCount(slot);
+    }
 
     file.close();
     return true;
 }
 
 bool UserDatabase::saveToFile(const char* filename) {
+    // Our own file is updated in place, slot by slot
+    if (isOwnFile(filename)) {
+        if (!flushDirtySlots()) {
+            return false; // Keep the log: it still covers the changes
+        }
+        if (log) {
+            log->truncate();
+        }
+        return true;
+    }
+    
+    // Any other file gets a full, compact copy
     // Open file in binary mode with truncation
     ofstream file(filename, ios::out | ios::binary | ios::trunc);
     if (!file.is_open()) {
@@ -96,6 +153,7 @@ bool UserDatabase::saveToFile(const char* filename) {
     }
 
     file.close();
+    lastSaveBytes = users.size() * sizeof(UserRecord);
     return true;
 }
 
@@ -112,12 +170,17 @@ bool UserDatabase::clearFile(const char* filename) {
     // Delete all users except default admin
     for (auto it = users.begin(); it != users.end();) {
         if (*it != defaultAdmin) {
-            delete *it;  // Free memory
-            it = users.erase(it);  // Remove from set and get next iterator
+            diskSlots.release((*it)->getuserNumber());
+            User* user = *it;
+            auto next = std::next(it);
+            eraseUser(it);  // Remove from set
+            delete user;    // Free memory
+            it = next;
         } else {
             ++it;  // Skip default admin
         }
     }
+    UserFactory::releaseUnusedMemory(); // Slabs emptied by the removals
     
     // Open file in binary mode with truncation
     ofstream file(filename, ios::out | ios::binary | ios::trunc);
@@ -131,6 +194,17 @@ bool UserDatabase::clearFile(const char* filename) {
     }
     
     file.close();
+    
+    // The removals are not logged: persist them through a checkpoint
+    if (isOwnFile(filename)) {
+        WriteAheadLog::syncFile(filename);
+        log->truncate();
+        diskSlots.rebuild(defaultAdmin 
+            ? vector<u_int32_t>(1, defaultAdmin->getuserNumber())
+            : vector<u_int32_t>());
+    } else {
+        checkpoint();
+    }
     return true;
 }
 
@@ -171,8 +245,11 @@ bool UserDatabase::addUser(User* user) {
     }
     
     // Insert the user into the set
-    auto result = users.insert(user);
-    return result.second; // Return true if insertion was successful
+    bool inserted = insertUser(user);
+    if (inserted) {
+        logMutation(WriteAheadLog::ADD, user);
+    }
+    return inserted; // Return true if insertion was successful
 }
 
 bool UserDatabase::updateUser(User* user) {
@@ -187,14 +264,15 @@ bool UserDatabase::updateUser(User* user) {
     }
     
     // Remove the existing user (keeping the pointer for later deletion)
-    users.erase(existingUser);
+    eraseUser(users.find(existingUser));
     
     // Add the updated user
-    users.insert(user);
+    insertUser(user);
     
     // Clean up the old user object
     delete existingUser;
     
+    logMutation(WriteAheadLog::UPDATE, user);
     return true;
 }
 
@@ -231,10 +309,11 @@ bool UserDatabase::removeUser(User* user) {
     }
     
     // Remove user from set
-    users.erase(it);
+    eraseUser(it);
     
-    // Save changes to file
-    saveToFile(filename);
+    // Make the removal durable right away (one log append, no full rewrite)
+    logMutation(WriteAheadLog::REMOVE, user);
+    commitLog();
     
     return true;
 }
@@ -294,11 +373,110 @@ bool UserDatabase::changeUserPass(User* activeUser, User* targetUser) {
     
     // Set the new password
     targetUser->setPwd(newPassword);
+    logMutation(WriteAheadLog::UPDATE, targetUser);
     
     // cout << "Password changed successfully." << endl;
     return true;
 }
 
-std::set<User*> UserDatabase::getAllUsers() const {
-    return users;
-}
\ No newline at end of file
+// Group commit: write every buffered mutation with a single fsync
+bool UserDatabase::commitLog() {
+    return log->commit();
+}
+
+// Fold the log into the snapshot file and start an empty log
+bool UserDatabase::checkpoint() {
+    return saveToFile(filename);
+}
+
+// Rewrite the changed slots of our own file (tombstones first)
+bool UserDatabase::flushDirtySlots() {
+    UserRecord tombstone = UserFactory::tombstoneRecord();
+    return diskSlots.flush(filename, &tombstone, 
+        [this](u_int32_t userNumber, void* out) {
+            const User* user = findUserByNumber(userNumber);
+            if (!user) {
+                return false;
+            }
+            *static_cast<UserRecord*>(out) = UserFactory::userToRecord(user);
+            return true;
+        }, &lastSaveBytes);
+}
+
+// Keep the slot map in step with a mutation: removals free their slot,
+// everything else dirties it
+void UserDatabase::trackDiskSlot(WriteAheadLog::Operation operation, 
+                                 u_int32_t userNumber) {
+    if (operation == WriteAheadLog::REMOVE) {
+        diskSlots.release(userNumber);
+    } else {
+        diskSlots.markDirty(userNumber);
+    }
+}
+
+void UserDatabase::logMutation(WriteAheadLog::Operation operation, 
+                               const User* user) {
+    trackDiskSlot(operation, user->getuserNumber());
+    if (!log) {
+        return; // Still loading: nothing to log
+    }
+    UserRecord record = UserFactory::userToRecord(user);
+    log->append(operation, user->getuserNumber(), &record);
+    
+    if (log->needsCheckpoint()) {
+        checkpoint();
+    }
+}
+
+// Re-apply one logged mutation on top of the loaded snapshot
+void UserDatabase::applyLogEntry(const WriteAheadLog::Entry& entry) {
+    const UserRecord& record = *static_cast<const UserRecord*>(entry.payload);
+    User* existing = findUserByNumber(entry.key);
+    
+    switch (entry.operation) {
+        case WriteAheadLog::ADD:
+        case WriteAheadLog::UPDATE: {
+            User* user = UserFactory::recordToUser(record);
+            if (!user) {
+                break;
+            }
+            if (existing) {
+                eraseUser(users.find(existing));
+                delete existing;
+            }
+            insertUser(user);
+            trackDiskSlot(entry.operation, entry.key);
+            break;
+        }
+        case WriteAheadLog::REMOVE:
+            if (existing && existing->getuserNumber() != 10000) {
+                eraseUser(users.find(existing));
+                delete existing;
+                trackDiskSlot(entry.operation, entry.key);
+            }
+            break;
+        case WriteAheadLog::READING:
+            break; // Not used for users
+    }
+}
+
+bool UserDatabase::isOwnFile(const char* filename) const {
+    return strcmp(filename, this->filename) == 0;
+}
+
+size_t UserDatabase::countUsersWithRole(User::Role role) const {
+    return (role < User::ROLE_COUNT) ? roleCounts[role] : 0;
+}
+
+bool UserDatabase::insertUser(User* user) {
+    if (!users.insert(user).second) {
+        return false;
+    }
+    roleCounts[user->getRole()]++;
+    return true;
+}
+
+void UserDatabase::eraseUser(std::set<User*>::iterator it) {
+    roleCounts[(*it)->getRole()]--;
+    users.erase(it);
+}
@@ -5,11 +5,34 @@
 #include <string>
 #include "../Users/User.h"
 #include "Database.h"
+#include "WriteAheadLog.h"
+#include "RecordSlotMap.h"
+#include "FilteredRange.h"
 
 class User;
 
 class UserDatabase : public Database {
 public:
+    // Predicates for getUsers() / forEachUser()
+    struct ByRole {
+        explicit ByRole(User::Role role) : role(role) {}
+        bool operator()(const User* user) const { 
+            return user->getRole() == role; 
+        }
+        User::Role role;
+    };
+
+    struct ByNumberRange {
+        ByNumberRange(u_int32_t first, u_int32_t last) 
+            : first(first), last(last) {}
+        bool operator()(const User* user) const {
+            return user->getuserNumber() >= first && 
+                   user->getuserNumber() <= last;
+        }
+        u_int32_t first;
+        u_int32_t last;
+    };
+
     UserDatabase(const char* filename = "users.dat");
     ~UserDatabase();
 
@@ -26,11 +49,64 @@ public:
     User* findUserByNumber(u_int32_t userNumber) const;
     bool changeUserPass(User* activeUser, User* targetUser);
 
-    // Single getter 
-    std::set<User*> getAllUsers() const;
+    // Durability (write-ahead log + snapshot checkpoints)
+    bool commitLog();
+    bool checkpoint();
+    size_t getLastSaveBytes() const { return lastSaveBytes; }
+
+    // In-place access to every user (no copies; invalidated by add/remove)
+    const std::set<User*>& getAllUsers() const { return users; }
+    size_t getUserCount() const { return users.size(); }
+
+    // Users per role, maintained on every insert/erase (O(1))
+    size_t countUsersWithRole(User::Role role) const;
+
+    // Users matching a predicate, e.g. getUsers(ByRole(User::ADMIN))
+    template <typename Predicate>
+    FilteredRange<std::set<User*>, Predicate> getUsers(Predicate match) const {
+        return FilteredRange<std::set<User*>, Predicate>(users, match);
+    }
+
+    // Call visit(User*) on every user, or on those matching 'match'
+    template <typename Visitor>
+    void forEachUser(Visitor visit) const {
+        for (User* user : users) {
+            visit(user);
+        }
+    }
+
+    template <typename Predicate, typename Visitor>
+    void forEachUser(Predicate match, Visitor visit) const {
+        for (User* user : users) {
+            if (match(user)) {
+                visit(user);
+            }
+        }
+    }
 
 private:
     std::set<User*> users;
+    size_t roleCounts[User::ROLE_COUNT];
+
+    // Mutations not yet folded into the snapshot file
+    WriteAheadLog* log;
+
+    // Record slot of each user in our own file, changed users and freed
+    // slots, so saves rewrite only what changed
+    RecordSlotMap diskSlots;
+    size_t lastSaveBytes;
+
+    // Write-ahead log helpers
+    void logMutation(WriteAheadLog::Operation operation, const User* user);
+    void applyLogEntry(const WriteAheadLog::Entry& entry);
+    bool isOwnFile(const char* filename) const;
+    void trackDiskSlot(WriteAheadLog::Operation operation, 
+                       u_int32_t userNumber);
+    bool flushDirtySlots();
+
+    // Set maintenance helpers (keep roleCounts in sync)
+    bool insertUser(User* user);
+    void eraseUser(std::set<User*>::iterator it);
 };
 
 #endif // USERDATABASE_H
\ No newline at end of file
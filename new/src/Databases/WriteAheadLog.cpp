@@ -0,0 +1,285 @@
+#include "WriteAheadLog.h"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <memory>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+using namespace std;
+
+// Out-of-line definitions for the ODR-used constants
+constexpr size_t WriteAheadLog::DEFAULT_GROUP_SIZE;
+constexpr size_t WriteAheadLog::DEFAULT_CHECKPOINT_INTERVAL;
+constexpr u_int32_t WriteAheadLog::ENTRY_MAGIC;
+
+WriteAheadLog::WriteAheadLog(const string& filename, size_t payloadSize,
+                             size_t groupSize, size_t checkpointInterval)
+    : filename(filename), payloadSize(payloadSize),
+      groupSize(groupSize == 0 ? 1 : groupSize),
+      checkpointInterval(checkpointInterval), fd(-1), pending(0),
+      sinceCheckpoint(0) {
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        cerr << "Warning: Could not open write-ahead log '" << filename
+             << "': " << strerror(errno) << endl;
+    }
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    commit();
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+void WriteAheadLog::append(Operation operation, u_int32_t key,
+                           const void* payload) {
+    EntryHeader header;
+    header.magic = ENTRY_MAGIC;
+    header.operation = operation;
+    header.key = key;
+    header.checksum = checksum(header, static_cast<const char*>(payload),
+                               payloadSize);
+
+    const char* headerBytes = reinterpret_cast<const char*>(&header);
+    const char* payloadBytes = static_cast<const char*>(payload);
+    buffer.insert(buffer.end(), headerBytes, headerBytes + sizeof(header));
+    buffer.insert(buffer.end(), payloadBytes, payloadBytes + payloadSize);
+    pending++;
+    sinceCheckpoint++;
+
+    // Group commit: one write + fsync for the whole batch
+    if (pending >= groupSize) {
+        commitAsync();
+    }
+}
+
+/**
+ * @brief Write the pending group and make it durable
+ *
+ * @return true if every buffered entry reached stable storage (or there
+ *         was nothing to commit), false on I/O error
+ */
+bool WriteAheadLog::commit() {
+    // Earlier groups still being written go first
+    waitForBackground();
+
+    if (pending == 0) {
+        return true;
+    }
+    if (fd < 0) {
+        return false;
+    }
+
+    if (!writeAll(fd, buffer.data(), buffer.size())) {
+        return false;
+    }
+
+    if (fdatasync(fd) != 0) {
+        cerr << "Error: Write-ahead log sync failed: "
+             << strerror(errno) << endl;
+        return false;
+    }
+
+    buffer.clear();
+    pending = 0;
+    return true;
+}
+
+size_t WriteAheadLog::replay(const function<void(const Entry&)>& apply) {
+    if (fd < 0) {
+        return 0;
+    }
+
+    vector<char> payload(payloadSize);
+    size_t applied = 0;
+    off_t offset = 0;
+
+    while (true) {
+        EntryHeader header;
+        ssize_t n = pread(fd, &header, sizeof(header), offset);
+        if (n != static_cast<ssize_t>(sizeof(header)) ||
+            header.magic != ENTRY_MAGIC) {
+            break;
+        }
+        n = pread(fd, payload.data(), payloadSize, offset + sizeof(header));
+        if (n != static_cast<ssize_t>(payloadSize) ||
+            header.checksum != checksum(header, payload.data(), payloadSize)) {
+            cerr << "Warning: Ignoring torn tail of write-ahead log '"
+                 << filename << "'" << endl;
+            break;
+        }
+
+        Entry entry;
+        entry.operation = static_cast<Operation>(header.operation);
+        entry.key = header.key;
+        entry.payload = payload.data();
+        apply(entry);
+
+        applied++;
+        offset += sizeof(header) + payloadSize;
+    }
+
+    sinceCheckpoint = applied + pending;
+    return applied;
+}
+
+bool WriteAheadLog::truncate() {
+    // Anything still pending is covered by the snapshot just written
+    waitForBackground();
+    buffer.clear();
+    pending = 0;
+    sinceCheckpoint = 0;
+
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, 0) != 0 || fdatasync(fd) != 0) {
+        cerr << "Error: Could not truncate write-ahead log '"
+             << filename << "'" << endl;
+        return false;
+    }
+    return true;
+}
+
+bool WriteAheadLog::rotate() {
+    if (fd < 0 || access(retiredPath().c_str(), F_OK) == 0) {
+        return false;
+    }
+
+    // The pending group belongs to the retired log
+    if (backgroundRun) {
+        queueCommit();
+    } else if (!commit()) {
+        return false;
+    }
+
+    // Queued writes hold their own descriptor, so the file can be renamed
+    // and this one closed right away
+    if (rename(filename.c_str(), retiredPath().c_str()) != 0) {
+        cerr << "Error: Could not rotate write-ahead log '" << filename
+             << "': " << strerror(errno) << endl;
+        return false;
+    }
+    ::close(fd);
+    fd = ::open(filename.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        cerr << "Warning: Could not reopen write-ahead log '" << filename
+             << "': " << strerror(errno) << endl;
+    }
+
+    sinceCheckpoint = 0;
+    return true;
+}
+
+void WriteAheadLog::setBackgroundCommit(const TaskRunner& run,
+                                        const function<void()>& drain) {
+    waitForBackground();
+    backgroundRun = run;
+    backgroundDrain = drain;
+}
+
+// Queue the pending group on the background thread
+void WriteAheadLog::queueCommit() {
+    if (pending == 0 || fd < 0) {
+        return;
+    }
+
+    std::shared_ptr<vector<char> > group = std::make_shared<vector<char> >();
+    group->swap(buffer);
+    pending = 0;
+
+    int groupFd = dup(fd);
+    string logName = filename;
+    backgroundRun([group, groupFd, logName]() {
+        if (groupFd < 0) {
+            return;
+        }
+        if (!writeAll(groupFd, group->data(), group->size()) ||
+            fdatasync(groupFd) != 0) {
+            cerr << "Error: Background commit to '" << logName
+                 << "' failed" << endl;
+        }
+        ::close(groupFd);
+    });
+}
+
+void WriteAheadLog::commitAsync() {
+    if (backgroundRun) {
+        queueCommit();
+    } else {
+        commit();
+    }
+}
+
+void WriteAheadLog::waitForBackground() {
+    if (backgroundDrain) {
+        backgroundDrain();
+    }
+}
+
+bool WriteAheadLog::writeAll(int fd, const char* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+        ssize_t n = ::write(fd, data + written, size - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            cerr << "Error: Write-ahead log append failed: "
+                 << strerror(errno) << endl;
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool WriteAheadLog::needsCheckpoint() const {
+    return checkpointInterval > 0 && sinceCheckpoint >= checkpointInterval;
+}
+
+string WriteAheadLog::logPathFor(const char* dataFile) {
+    string path(dataFile);
+    size_t len = path.length();
+    if (len >= 4 && path.compare(len - 4, 4, ".dat") == 0) {
+        path.replace(len - 4, 4, ".wal");
+    } else {
+        path += ".wal";
+    }
+    return path;
+}
+
+bool WriteAheadLog::hasPendingChanges(const char* dataFile) {
+    string path = logPathFor(dataFile);
+    struct stat info;
+    if (stat(path.c_str(), &info) == 0 && info.st_size > 0) {
+        return true;
+    }
+    return access((path + ".prev").c_str(), F_OK) == 0;
+}
+
+bool WriteAheadLog::syncFile(const char* path) {
+    int fileFd = ::open(path, O_RDONLY);
+    if (fileFd < 0) {
+        return false;
+    }
+    bool synced = (fsync(fileFd) == 0);
+    ::close(fileFd);
+    return synced;
+}
+
+// FNV-1a over the fields that identify the mutation
+u_int32_t WriteAheadLog::checksum(const EntryHeader& header,
+                                  const char* payload, size_t size) {
+    u_int32_t hash = 2166136261u;
+    const u_int32_t fields[] = { header.operation, header.key };
+    const char* bytes = reinterpret_cast<const char*>(fields);
+    for (size_t i = 0; i < sizeof(fields); i++) {
+        hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 16777619u;
+    }
+    for (size_t i = 0; i < size; i++) {
+        hash = (hash ^ static_cast<unsigned char>(payload[i])) * 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,128 @@
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <sys/types.h>
+
+/**
+ * @brief Append-only write-ahead log of typed mutation records
+ *
+ * Each database keeps one log next to its .dat snapshot (users.wal,
+ * sensors.wal). Mutations are appended to an in-memory group and written
+ * with a single write() + fdatasync() on commit(), so a burst of changes
+ * costs one sequential append instead of rewriting the whole snapshot.
+ * The owning database replays the log after loading its snapshot and
+ * truncates it after each checkpoint.
+ *
+ * Background checkpoints rotate the log instead: the current file is
+ * renamed to retiredPath() and covered by the snapshot being written,
+ * while new mutations go to a fresh log. Full groups can also be committed
+ * on a background thread (setBackgroundCommit) so appends never wait for
+ * fsync; synchronous commits and truncation wait for those writes first.
+ *
+ * On-disk entry: EntryHeader followed by 'payloadSize' bytes (a fixed-size
+ * SensorRecord or UserRecord). Replay stops at the first torn or corrupt
+ * entry, which can only be the tail of an interrupted commit.
+ */
+class WriteAheadLog {
+public:
+    static constexpr size_t DEFAULT_GROUP_SIZE = 64;          // Entries
+    static constexpr size_t DEFAULT_CHECKPOINT_INTERVAL = 4096; // Entries
+
+    enum Operation : u_int32_t {
+        ADD = 1,
+        UPDATE = 2,   // 'key' holds the previous ID (ID changes)
+        REMOVE = 3,
+        READING = 4   // New sensor data only
+    };
+
+    // Entry handed to the replay callback; 'payload' points into a buffer
+    // that is only valid during the callback
+    struct Entry {
+        Operation operation;
+        u_int32_t key;
+        const void* payload;
+    };
+
+    WriteAheadLog(const std::string& filename, size_t payloadSize,
+                  size_t groupSize = DEFAULT_GROUP_SIZE,
+                  size_t checkpointInterval = DEFAULT_CHECKPOINT_INTERVAL);
+    ~WriteAheadLog();
+
+    // Non-copyable: the log owns its file descriptor
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    // Buffer one mutation; commits automatically when the group is full
+    void append(Operation operation, u_int32_t key, const void* payload);
+
+    // Write every buffered entry and make it durable with one fsync
+    bool commit();
+
+    // Same, but queued on the background thread when one is configured
+    void commitAsync();
+
+    // Replay committed entries in order, returns the number applied
+    size_t replay(const std::function<void(const Entry&)>& apply);
+
+    // Discard the log contents once a snapshot has been checkpointed
+    bool truncate();
+
+    // Move the current contents to retiredPath() and continue in an empty
+    // log; false if an earlier retired log is still present
+    bool rotate();
+    std::string retiredPath() const { return filename + ".prev"; }
+
+    // Hand full groups to 'run' (queues a task on another thread); 'drain'
+    // must wait for every queued task. Empty functions restore inline commits
+    typedef std::function<void(const std::function<void()>&)> TaskRunner;
+    void setBackgroundCommit(const TaskRunner& run,
+                             const std::function<void()>& drain);
+
+    // Checkpoint policy
+    bool needsCheckpoint() const;
+    size_t pendingCount() const { return pending; }
+    size_t entriesSinceCheckpoint() const { return sinceCheckpoint; }
+
+    const std::string& getFilename() const { return filename; }
+
+    // Path of the log that belongs to a .dat snapshot ("x.dat" -> "x.wal")
+    static std::string logPathFor(const char* dataFile);
+    // Whether a .dat snapshot has logged changes not yet folded into it
+    // (a non-empty log, or a retired one)
+    static bool hasPendingChanges(const char* dataFile);
+
+    // Flush a finished file to stable storage
+    static bool syncFile(const char* path);
+
+private:
+    static constexpr u_int32_t ENTRY_MAGIC = 0x4C57564A; // "JVWL"
+
+    struct EntryHeader {
+        u_int32_t magic;
+        u_int32_t operation;
+        u_int32_t key;
+        u_int32_t checksum; // Over key, operation and payload
+    };
+
+    static u_int32_t checksum(const EntryHeader& header, const char* payload,
+                              size_t size);
+    static bool writeAll(int fd, const char* data, size_t size);
+    void queueCommit();
+    void waitForBackground();
+
+    std::string filename;
+    size_t payloadSize;
+    size_t groupSize;
+    size_t checkpointInterval;
+    int fd;
+    std::vector<char> buffer;   // Pending group, already serialized
+    size_t pending;             // Entries in 'buffer'
+    size_t sinceCheckpoint;     // Entries in the file plus pending ones
+    TaskRunner backgroundRun;
+    std::function<void()> backgroundDrain;
+};
+
+#endif // WRITEAHEADLOG_H
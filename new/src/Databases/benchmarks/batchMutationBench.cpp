@@ -0,0 +1,122 @@
+/**
+ * @file batchMutationBench.cpp
+ * @brief Provisioning and decommissioning: one call per sensor vs SensorBatch
+ *
+ * The same sensors are added and removed again, first one call at a time
+ * (addSensor / removeSensor, the latter committing every removal) and
+ * then through SensorDatabase::applyBatch. The batch run also moves every
+ * sensor to a new ID. Each step is reported in milliseconds, durable
+ * persistence included.
+ *
+ * Usage: ./bin/batch_mutation_bench [sensorCount]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+#include "../SensorDatabase.h"
+#include "../SensorBatch.h"
+#include "../WriteAheadLog.h"
+#include "../../Sensors/TemperatureSensor.h"
+#include "../../Sensors/Hygrometer.h"
+#include "../../Sensors/LuxMeterSensor.h"
+#include "../../Sensors/ContactSensor.h"
+
+using namespace std;
+
+namespace {
+    const char* BENCH_FILE = "bench_batch.dat";
+    const u_int32_t MAX_SENSORS = 40000; // Twice that many free IDs needed
+
+    // i-th non-primary ID: each block of 10000 IDs starts with a primary
+    u_int32_t idAt(u_int32_t i) {
+        return 10000 * (1 + i / 9999) + 1 + i % 9999;
+    }
+
+    Sensor* makeSensor(u_int32_t sensorId) {
+        switch (sensorId % 4) {
+            case 0: return new TemperatureSensor(sensorId);
+            case 1: return new Hygrometer(sensorId);
+            case 2: return new LuxMeterSensor(sensorId);
+            default: return new ContactSensor(sensorId);
+        }
+    }
+
+    double timeMs(const function<void()>& step) {
+        auto begin = chrono::steady_clock::now();
+        step();
+        return chrono::duration<double, milli>(
+            chrono::steady_clock::now() - begin).count();
+    }
+
+    void report(const string& step, double ms) {
+        cout << setw(28) << left << step << right << fixed << setprecision(2)
+             << setw(12) << ms << " ms" << endl;
+    }
+
+    void resetFiles() {
+        fclose(fopen(BENCH_FILE, "w")); // Start from an empty file
+        remove(WriteAheadLog::logPathFor(BENCH_FILE).c_str());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    u_int32_t count = (argc > 1) ? static_cast<u_int32_t>(atoi(argv[1]))
+                                 : 10000;
+    if (count == 0 || count > MAX_SENSORS) {
+        cerr << "Sensor count must be between 1 and " << MAX_SENSORS << endl;
+        return 1;
+    }
+
+    cout << "=== SENSOR DATABASE: BATCH MUTATIONS ===" << endl;
+    cout << count << " sensors added and removed" << endl;
+    cout << endl;
+
+    resetFiles();
+    {
+        SensorDatabase db(BENCH_FILE);
+        report("addSensor x N + commit", timeMs([&]() {
+            for (u_int32_t i = 0; i < count; i++) {
+                db.addSensor(makeSensor(idAt(i)));
+            }
+            db.commitLog();
+        }));
+        report("removeSensor x N", timeMs([&]() {
+            for (u_int32_t i = 0; i < count; i++) {
+                db.removeSensor(db.findSensorById(idAt(i)));
+            }
+        }));
+    }
+
+    resetFiles();
+    {
+        SensorDatabase db(BENCH_FILE);
+        SensorBatch batch;
+        report("applyBatch: add N", timeMs([&]() {
+            for (u_int32_t i = 0; i < count; i++) {
+                batch.add(makeSensor(idAt(i)));
+            }
+            db.applyBatch(batch);
+        }));
+        report("applyBatch: change N IDs", timeMs([&]() {
+            for (u_int32_t i = 0; i < count; i++) {
+                batch.changeId(idAt(i), idAt(count + i));
+            }
+            db.applyBatch(batch);
+        }));
+        report("applyBatch: remove N", timeMs([&]() {
+            for (u_int32_t i = 0; i < count; i++) {
+                batch.remove(idAt(count + i));
+            }
+            db.applyBatch(batch);
+        }));
+    }
+
+    remove(BENCH_FILE);
+    remove(WriteAheadLog::logPathFor(BENCH_FILE).c_str());
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file batchSamplingBench.cpp
+ * @brief Sampling throughput: collectData() per sensor vs batches per type
+ *
+ * Every type gets a full ID block of sensors. Each round samples all of
+ * them, first with one virtual collectData() call per sensor and then
+ * with one SensorFactory::collectBatch() call per type. Both run on one
+ * thread; samples per second are reported per type and overall. Readings
+ * come from the default SimulatedHardware, so every run takes the same.
+ *
+ * Usage: ./bin/batch_sampling_bench [sensorsPerType] [rounds]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <cstdlib>
+#include "../SensorManifest.h"
+#include "../../Sensors/SensorFactory.h"
+
+using namespace std;
+
+namespace {
+    const u_int32_t BLOCK_SIZE = 9999; // Non-primary IDs of a type's block
+
+    double timeMs(const function<void()>& step) {
+        auto begin = chrono::steady_clock::now();
+        step();
+        return chrono::duration<double, milli>(
+            chrono::steady_clock::now() - begin).count();
+    }
+
+    double millionsPerSecond(size_t samples, double ms) {
+        return samples / ms / 1e3;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    u_int32_t perType = (argc > 1) ? static_cast<u_int32_t>(atoi(argv[1]))
+                                   : BLOCK_SIZE;
+    size_t rounds = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 50;
+    if (perType == 0 || perType > BLOCK_SIZE) {
+        perType = BLOCK_SIZE;
+    }
+    if (rounds == 0) {
+        rounds = 1;
+    }
+
+    // Same ID blocks as the manifest defaults, primaries left out
+    vector<Sensor*> sensors[Sensor::TYPE_COUNT];
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        u_int32_t first = 10000 * static_cast<u_int32_t>(type + 1) + 1;
+        for (u_int32_t i = 0; i < perType; i++) {
+            sensors[type].push_back(SensorFactory::createUnsampled(
+                static_cast<Sensor::Type>(type), first + i));
+        }
+    }
+
+    cout << "=== SENSOR SAMPLING: PER SENSOR vs BATCH PER TYPE ===" << endl;
+    cout << perType << " sensors per type, " << rounds << " rounds" << endl;
+    cout << endl;
+    cout << setw(16) << left << "Type" << right
+         << setw(18) << "Per sensor (M/s)"
+         << setw(14) << "Batch (M/s)"
+         << setw(10) << "Speedup" << endl;
+
+    double totalSingle = 0.0;
+    double totalBatch = 0.0;
+    size_t totalSamples = 0;
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        vector<Sensor*>& list = sensors[type];
+        Sensor::Type sensorType = static_cast<Sensor::Type>(type);
+
+        double single = timeMs([&list, rounds]() {
+            for (size_t round = 0; round < rounds; round++) {
+                for (Sensor* sensor : list) {
+                    sensor->collectData();
+                }
+            }
+        });
+        double batch = timeMs([&list, rounds, sensorType]() {
+            for (size_t round = 0; round < rounds; round++) {
+                SensorFactory::collectBatch(sensorType, list.data(),
+                                            list.size());
+            }
+        });
+
+        size_t samples = list.size() * rounds;
+        totalSingle += single;
+        totalBatch += batch;
+        totalSamples += samples;
+        cout << setw(16) << left << SensorManifest::typeName(sensorType)
+             << right << fixed << setprecision(2)
+             << setw(18) << millionsPerSecond(samples, single)
+             << setw(14) << millionsPerSecond(samples, batch)
+             << setw(9) << single / batch << "x" << endl;
+    }
+    cout << setw(16) << left << "All types" << right
+         << setw(18) << millionsPerSecond(totalSamples, totalSingle)
+         << setw(14) << millionsPerSecond(totalSamples, totalBatch)
+         << setw(9) << totalSingle / totalBatch << "x" << endl;
+
+    for (vector<Sensor*>& list : sensors) {
+        for (Sensor* sensor : list) {
+            delete sensor;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,115 @@
+/**
+ * @file collectionCycleBench.cpp
+ * @brief Full collection sweeps with CollectionEngine at several thread counts
+ *
+ * The database is provisioned with every sensor type (cameras included)
+ * and background snapshots enabled, as in the monitoring system. Each
+ * thread count runs the same number of cycles; the averages of each
+ * phase and the sampling throughput are reported.
+ *
+ * Usage: ./bin/collection_cycle_bench [sensorCount] [cycles] [maxThreads]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <cstdio>
+#include <cstdlib>
+#include "../SensorDatabase.h"
+#include "../SensorManifest.h"
+#include "../WriteAheadLog.h"
+#include "../../Sensors/Coordination/CollectionEngine.h"
+
+using namespace std;
+
+namespace {
+    const char* BENCH_FILE = "bench_collection.dat";
+
+    // Share of the sensors per type, in percent (cameras are the minority)
+    const unsigned TYPE_SHARE[Sensor::TYPE_COUNT] = {18, 18, 18, 18, 18, 5, 5};
+
+    void resetFiles() {
+        fclose(fopen(BENCH_FILE, "w")); // Start from an empty file
+        remove(WriteAheadLog::logPathFor(BENCH_FILE).c_str());
+        remove((WriteAheadLog::logPathFor(BENCH_FILE) + ".prev").c_str());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t sensorCount = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 89993;
+    size_t cycles = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 20;
+    unsigned maxThreads = (argc > 3) ? static_cast<unsigned>(atoi(argv[3]))
+                                     : thread::hardware_concurrency();
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+    if (cycles == 0) {
+        cycles = 1;
+    }
+
+    // Whole ID space, lowest free IDs first
+    SensorManifest manifest;
+    size_t assigned = 0;
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        size_t count = (type + 1 == Sensor::TYPE_COUNT)
+                     ? sensorCount - assigned
+                     : sensorCount * TYPE_SHARE[type] / 100;
+        manifest.addEntry(static_cast<Sensor::Type>(type),
+                          static_cast<u_int32_t>(count),
+                          Sensor::MIN_SENSOR_ID, Sensor::MAX_SENSOR_ID);
+        assigned += count;
+    }
+
+    resetFiles();
+    {
+        SensorDatabase db(BENCH_FILE);
+        db.setSnapshotCadence(30);
+        db.provision(manifest);
+
+        cout << "=== COLLECTION ENGINE: FULL SWEEPS ===" << endl;
+        cout << db.getSensorCount() << " sensors, " << cycles
+             << " cycles per thread count" << endl;
+        cout << "Hardware threads: " << thread::hardware_concurrency() << endl;
+        cout << endl;
+        cout << setw(8) << "Threads"
+             << setw(13) << "Sample (ms)"
+             << setw(13) << "Record (ms)"
+             << setw(12) << "Cycle (ms)"
+             << setw(18) << "Samples/s (M)" << endl;
+
+        vector<unsigned> counts;
+        for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+            counts.push_back(threads);
+        }
+        counts.push_back(maxThreads);
+
+        for (unsigned threads : counts) {
+            CollectionEngine engine(db, threads);
+            engine.runCycle(); // Warm-up
+            db.commitLog();
+
+            double sample = 0.0;
+            double record = 0.0;
+            double total = 0.0;
+            for (size_t i = 0; i < cycles; i++) {
+                const CollectionEngine::CycleStats& cycle = engine.runCycle();
+                sample += cycle.primaryMs + cycle.parallelMs;
+                record += cycle.recordMs;
+                total += cycle.totalMs;
+                db.commitLog();
+            }
+
+            cout << setw(8) << threads << fixed << setprecision(2)
+                 << setw(13) << sample / cycles
+                 << setw(13) << record / cycles
+                 << setw(12) << total / cycles
+                 << setw(18) << db.getSensorCount() / (sample / cycles) / 1e3
+                 << endl;
+        }
+    }
+
+    remove(BENCH_FILE);
+    remove(WriteAheadLog::logPathFor(BENCH_FILE).c_str());
+    return 0;
+}
@@ -0,0 +1,154 @@
+/**
+ * @file columnarScanBench.cpp
+ * @brief Bulk scans: SensorDatabase objects vs ColumnarSensorDatabase columns
+ *
+ * Both databases hold the same sensors (every type, cameras included).
+ * Each scan is repeated and reported in nanoseconds per sensor:
+ *
+ *  - type histogram   all sensors, type only
+ *  - ID range count   all sensors, ID only
+ *  - threshold check  all sensors, type and reading (temperature > 25)
+ *  - compact export   whole file encoded in memory
+ *
+ * Usage: ./bin/columnar_scan_bench [sensorCount] [repetitions]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "../SensorDatabase.h"
+#include "../ColumnarSensorDatabase.h"
+#include "../SensorFileFormat.h"
+#include "../../Sensors/SensorFactory.h"
+
+using namespace std;
+
+namespace {
+    const char* BENCH_FILE = "bench_columns.dat";
+    const u_int32_t FIRST_ID = 10001;
+    const int THRESHOLD = 25;
+
+    volatile size_t sink; // Keeps the scans from being optimized away
+
+    // Average nanoseconds per sensor of 'scan' over 'repetitions' runs
+    double timeScan(const function<size_t()>& scan, size_t repetitions,
+                    size_t sensorCount) {
+        auto begin = chrono::steady_clock::now();
+        for (size_t i = 0; i < repetitions; i++) {
+            sink = scan();
+        }
+        double ns = chrono::duration<double, nano>(
+            chrono::steady_clock::now() - begin).count();
+        return ns / repetitions / sensorCount;
+    }
+
+    void report(const char* name, double objects, double columns) {
+        cout << setw(18) << name << fixed << setprecision(2)
+             << setw(14) << objects << setw(14) << columns
+             << setw(9) << objects / columns << "x" << endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t sensorCount = (argc > 1) ? strtoul(argv[1], nullptr, 10) : 80000;
+    size_t repetitions = (argc > 2) ? strtoul(argv[2], nullptr, 10) : 50;
+
+    // Same contents in both layouts: fill the columns, save, load objects
+    fclose(fopen(BENCH_FILE, "w")); // Start from an empty file
+    remove(WriteAheadLog::logPathFor(BENCH_FILE).c_str());
+    ColumnarSensorDatabase* columnar = new ColumnarSensorDatabase(BENCH_FILE);
+    for (u_int32_t id = FIRST_ID; columnar->getSensorCount() < sensorCount &&
+                                  id <= Sensor::MAX_SENSOR_ID; id++) {
+        if (Sensor::isPrimarySensorId(id)) {
+            continue;
+        }
+        SensorRecord record;
+        memset(&record, 0, sizeof(record));
+        record.sensorId = id;
+        record.sensorType = id % Sensor::TYPE_COUNT;
+        for (size_t i = 0; i < Sensor::MAX_DATA_SIZE; i++) {
+            record.data[i] = static_cast<int>((id * 7 + i) % 50);
+        }
+        Sensor* sensor = SensorFactory::recordToSensor(record);
+        columnar->addSensor(sensor);
+        delete sensor;
+    }
+    columnar->saveToFile(BENCH_FILE);
+    SensorDatabase* objectStore = new SensorDatabase(BENCH_FILE);
+    const SensorDatabase& objects = *objectStore;
+    sensorCount = objects.getSensorCount();
+
+    cout << "\n=== COLUMNAR VS OBJECT LAYOUT: BULK SCANS ===" << endl;
+    cout << sensorCount << " sensors, " << repetitions
+         << " repetitions, ns per sensor" << endl;
+    cout << endl;
+    cout << setw(18) << "Scan" << setw(14) << "Objects"
+         << setw(14) << "Columns" << setw(10) << "Speedup" << endl;
+
+    // Type histogram
+    double objectNs = timeScan([&]() {
+        size_t counts[Sensor::TYPE_COUNT] = {0};
+        for (const Sensor* sensor : objects.getAllSensors()) {
+            counts[sensor->getType()]++;
+        }
+        return counts[Sensor::RGB_CAMERA];
+    }, repetitions, sensorCount);
+    double columnNs = timeScan([&]() {
+        size_t counts[Sensor::TYPE_COUNT];
+        columnar->countByType(counts);
+        return counts[Sensor::RGB_CAMERA];
+    }, repetitions, sensorCount);
+    report("type histogram", objectNs, columnNs);
+
+    // ID range count
+    objectNs = timeScan([&]() {
+        size_t count = 0;
+        for (const Sensor* sensor : objects.getAllSensors()) {
+            count += (sensor->getSensorId() >= 20000 &&
+                      sensor->getSensorId() < 30000);
+        }
+        return count;
+    }, repetitions, sensorCount);
+    columnNs = timeScan([&]() {
+        size_t count = 0;
+        for (u_int32_t id : columnar->idColumn()) {
+            count += (id >= 20000 && id < 30000);
+        }
+        return count;
+    }, repetitions, sensorCount);
+    report("ID range count", objectNs, columnNs);
+
+    // Threshold check
+    objectNs = timeScan([&]() {
+        size_t count = 0;
+        for (const Sensor* sensor : objects.getAllSensors()) {
+            count += (sensor->getType() == Sensor::TEMPERATURE &&
+                      sensor->getSingleData() > THRESHOLD);
+        }
+        return count;
+    }, repetitions, sensorCount);
+    columnNs = timeScan([&]() {
+        return columnar->countAbove(Sensor::TEMPERATURE, THRESHOLD);
+    }, repetitions, sensorCount);
+    report("threshold check", objectNs, columnNs);
+
+    // Compact export
+    objectNs = timeScan([&]() {
+        return SensorFileFormat::encodeFile(objects.getAllSensors()).size();
+    }, repetitions, sensorCount);
+    columnNs = timeScan([&]() {
+        return columnar->exportCompact().size();
+    }, repetitions, sensorCount);
+    report("compact export", objectNs, columnNs);
+
+    delete objectStore;
+    delete columnar;
+    remove(BENCH_FILE);
+    remove(WriteAheadLog::logPathFor(BENCH_FILE).c_str());
+    return 0;
+}
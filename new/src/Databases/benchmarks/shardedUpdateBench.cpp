@@ -0,0 +1,165 @@
+/**
+ * @file shardedUpdateBench.cpp
+ * @brief Scaling of concurrent reading updates in ShardedSensorDatabase
+ *
+ * Collector threads update readings of random sensors while one admin
+ * thread keeps adding and removing sensors. Every COORDINATION_EVERY-th
+ * update is a collectData() of a master or a camera, so the coordinator
+ * state is written and read from every collector (run it under
+ * -fsanitize=thread to check for races). Each thread count is run
+ * against a single shard (one global lock) and against the default
+ * shard count, and the update throughput is reported for both.
+ *
+ * Usage: ./bin/sharded_update_bench [maxThreads] [updatesPerThread]
+ */
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include "../ShardedSensorDatabase.h"
+#include "../../Sensors/TemperatureSensor.h"
+#include "../../Sensors/Hygrometer.h"
+#include "../../Sensors/LuxMeterSensor.h"
+#include "../../Sensors/AirQualitySensor.h"
+#include "../../Sensors/ContactSensor.h"
+#include "../../Sensors/ThermalCamera.h"
+#include "../../Sensors/RGBCamera.h"
+
+using namespace std;
+
+namespace {
+    const char* BENCH_FILE = "bench_sensors.dat";
+    const u_int32_t FIRST_ID = 11000;       // Clear of the primary IDs
+    const u_int32_t SENSOR_COUNT = 20000;
+    const u_int32_t CHURN_FIRST_ID = 90000; // Added/removed by the admin
+    const size_t COORDINATION_EVERY = 16;
+
+    // Masters write the coordinator state, cameras read it
+    const u_int32_t COORDINATION_IDS[] = {
+        TemperatureSensor::PRIMARY_TEMP_ID, ContactSensor::PRIMARY_CONTACT_ID,
+        ThermalCamera::PRIMARY_THERMAL_ID, RGBCamera::PRIMARY_RGB_ID
+    };
+
+    Sensor* makeSensor(u_int32_t sensorId) {
+        switch (sensorId % 4) {
+            case 0: return new TemperatureSensor(sensorId);
+            case 1: return new Hygrometer(sensorId);
+            case 2: return new LuxMeterSensor(sensorId);
+            default: return new AirQualitySensor(sensorId);
+        }
+    }
+
+    // Updates per second with 'threads' collectors on 'shardCount' shards
+    double run(size_t shardCount, unsigned threads, size_t updatesPerThread) {
+        fclose(fopen(BENCH_FILE, "w")); // Start from an empty file
+        ShardedSensorDatabase db(BENCH_FILE, shardCount);
+        for (u_int32_t id = FIRST_ID; id < FIRST_ID + SENSOR_COUNT; id++) {
+            db.addSensor(makeSensor(id));
+        }
+        db.addSensor(new TemperatureSensor(TemperatureSensor::PRIMARY_TEMP_ID));
+        db.addSensor(new ContactSensor(ContactSensor::PRIMARY_CONTACT_ID));
+        db.addSensor(new ThermalCamera(ThermalCamera::PRIMARY_THERMAL_ID));
+        db.addSensor(new RGBCamera(RGBCamera::PRIMARY_RGB_ID));
+
+        atomic<bool> start(false);
+        atomic<unsigned> running(threads);
+
+        vector<thread> collectors;
+        for (unsigned t = 0; t < threads; t++) {
+            collectors.push_back(thread([&, t]() {
+                minstd_rand random(t + 1);
+                while (!start) {
+                    this_thread::yield();
+                }
+                for (size_t i = 0; i < updatesPerThread; i++) {
+                    if (i % COORDINATION_EVERY == 0) {
+                        db.collectData(COORDINATION_IDS[random() % 4]);
+                        continue;
+                    }
+                    u_int32_t id = FIRST_ID + random() % SENSOR_COUNT;
+                    int reading = static_cast<int>(i);
+                    db.updateSensor(id, [reading](Sensor& sensor) {
+                        sensor.setSingleData(reading);
+                    });
+                }
+                running--;
+            }));
+        }
+
+        // Admin operations on other sensors for as long as collectors run
+        thread admin([&]() {
+            while (!start) {
+                this_thread::yield();
+            }
+            u_int32_t next = CHURN_FIRST_ID;
+            while (running > 0) {
+                db.addSensor(makeSensor(next));
+                db.removeSensor(next);
+                next = (next == Sensor::MAX_SENSOR_ID) ? CHURN_FIRST_ID : next + 1;
+            }
+        });
+
+        auto begin = chrono::steady_clock::now();
+        start = true;
+        for (auto& collector : collectors) {
+            collector.join();
+        }
+        double seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - begin).count();
+        admin.join();
+
+        return threads * updatesPerThread / seconds;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    unsigned maxThreads = thread::hardware_concurrency();
+    if (argc > 1) {
+        maxThreads = static_cast<unsigned>(atoi(argv[1]));
+    }
+    if (maxThreads == 0) {
+        maxThreads = 1;
+    }
+    size_t updatesPerThread = (argc > 2) ? strtoul(argv[2], nullptr, 10)
+                                         : 1000000;
+
+    cout << "=== SHARDED SENSOR DATABASE: CONCURRENT UPDATES ===" << endl;
+    cout << SENSOR_COUNT << " sensors, " << updatesPerThread
+         << " updates per collector, 1 admin thread adding/removing" << endl;
+    cout << "Hardware threads: " << thread::hardware_concurrency() << endl;
+    cout << endl;
+    cout << setw(8) << "Threads"
+         << setw(18) << "1 shard (M/s)"
+         << setw(25) << to_string(ShardedSensorDatabase::DEFAULT_SHARD_COUNT) +
+                        " shards (M/s)"
+         << setw(10) << "Speedup" << endl;
+
+    double baseline = 0.0;
+    vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        counts.push_back(threads);
+    }
+    counts.push_back(maxThreads);
+
+    for (unsigned threads : counts) {
+        double global = run(1, threads, updatesPerThread);
+        double sharded = run(ShardedSensorDatabase::DEFAULT_SHARD_COUNT,
+                             threads, updatesPerThread);
+        if (baseline == 0.0) {
+            baseline = sharded;
+        }
+        cout << setw(8) << threads << fixed << setprecision(2)
+             << setw(18) << global / 1e6
+             << setw(25) << sharded / 1e6
+             << setw(9) << sharded / baseline << "x" << endl;
+    }
+
+    remove(BENCH_FILE);
+    return 0;
+}
@@ -3,8 +3,17 @@
 #include <string>
 #include <vector>
 #include <limits>
+#include <stdexcept>
+#include <cstdio>
 #include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #include "../SensorDatabase.h"
+#include "../SensorBatch.h"
+#include "../SensorManifest.h"
+#include "../SensorFileView.h"
+#include "../WriteAheadLog.h"
+#include "../../History/ReadingHistory.h"
 #include "../../Sensors/Sensor.h"
 #include "../../Sensors/TemperatureSensor.h"
 #include "../../Sensors/Hygrometer.h"
@@ -33,6 +42,7 @@ void testClearFile(SensorDatabase& db, const string& filename);
 void displaySensorDetails(const Sensor* sensor);
 void testSensorCoordination(SensorDatabase& db);
 void pauseExecution();
+int runChecks();
 
 /**
  * @file main.cpp
@@ -59,9 +69,17 @@ void pauseExecution();
  *
  * The database is automatically saved when the program exits.
  *
- * @return int Exit status code (0 for successful execution)
+ * With --check the automated behavior checks run instead of the menu
+ * (see runChecks), which is what "make check" does.
+ *
+ * @return int Exit status code (0 for successful execution, 1 if a check
+ *         failed)
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--check") {
+        return (runChecks() == 0) ? 0 : 1;
+    }
+
     cout << "=== SensorDatabase Testing Program ===" << endl;
     
     // Create a test database file
@@ -80,7 +98,7 @@ int main() {
     // Main program loop
     while (!exitProgram) {
         displayMenu();
-        choice = InputUtils::getNumberInRange("Enter your choice: ", 0, 9);
+        choice = InputUtils::getNumberInRange("Enter your choice: ", 0, 10);
         switch (choice) {
             case 1:
                 displaySensorList(db);
@@ -120,6 +138,10 @@ int main() {
                 break;
             }
 
+            case 10:
+                runChecks();
+                break;
+
             case 0:
                 exitProgram = true;
                 cout << "Exiting program. Database will be saved." << endl;
@@ -156,6 +178,7 @@ void displayMenu() {
     cout << "7. Clear database file" << endl;
     cout << "8. Test SensorCoordinator integration" << endl;
     cout << "9. Check Security Alarm" << endl;
+    cout << "10. Run automated checks" << endl;
     cout << "0. Exit" << endl;
     cout << "=============================================" << endl;
 }
@@ -171,7 +194,7 @@ void displayMenu() {
 void displaySensorList(const SensorDatabase& db) {
     cout << "\n=== SENSOR LIST ===" << endl;
     
-    auto sensors = db.getAllSensors();
+    const vector<Sensor*>& sensors = db.getAllSensors();
     
     if (sensors.empty()) {
         cout << "No sensors in database." << endl;
@@ -312,19 +335,14 @@ void testUpdateSensor(SensorDatabase& db) {
         cout << "\nChanging sensor ID from " << currentId << " to " << newId << endl;
         
         if (InputUtils::getConfirmation("Are you sure you want to change the sensor ID?")) {
-            // Simply update the sensor ID directly - no need to remove/re-add
-            sensor->setSensorId(newId);
-            
-            // Use updateSensor to refresh the database state
-            if (db.updateSensor(sensor)) {
+            // Change the ID through the database to keep its ID index in sync
+            if (db.changeSensorId(sensor, newId)) {
                 cout << "Sensor ID updated successfully!" << endl;
                 cout << "\nUpdated sensor details:" << endl;
                 displaySensorDetails(sensor);
                 cout << "\nNote: Use 'Test data collection' to get new measurements." << endl;
             } else {
                 cout << "Failed to update sensor ID!" << endl;
-                // Restore original ID on failure
-                sensor->setSensorId(currentId);
             }
         } else {
             cout << "ID change cancelled." << endl;
@@ -418,7 +436,7 @@ void testFindSensor(SensorDatabase& db) {
 void testCollectData(SensorDatabase& db) {
     cout << "\n=== DATA COLLECTION TEST ===" << endl;
     
-    auto sensors = db.getAllSensors();
+    const vector<Sensor*>& sensors = db.getAllSensors();
     
     if (sensors.empty()) {
         cout << "No sensors available for data collection." << endl;
@@ -448,6 +466,7 @@ void testCollectData(SensorDatabase& db) {
         
         cout << "  Collecting new data..." << endl;
         sensor->collectData();
+        db.recordReading(sensor); // Marks its slot for the next save
         
         cout << "  AFTER collection:  ";
         displaySensorDetails(sensor);
@@ -611,4 +630,489 @@ void testSensorCoordination(SensorDatabase& db) {
 void pauseExecution() {
     cout << "\nPress Enter to continue...";
     cin.ignore(numeric_limits<streamsize>::max(), '\n');
-}
\ No newline at end of file
+}
+// ===================== AUTOMATED CHECKS =====================
+// Each check works on its own scratch database (check_<name>.dat and its
+// logs), removed before and after, and never touches test_sensors.dat
+
+static int checksFailed = 0;
+
+/**
+ * @brief Reports one expectation of an automated check
+ *
+ * @param condition Whether the expectation holds
+ * @param what Description printed next to PASS or FAIL
+ */
+static void expect(bool condition, const string& what) {
+    cout << (condition ? "  PASS  " : "  FAIL  ") << what << endl;
+    if (!condition) {
+        checksFailed++;
+    }
+}
+
+/**
+ * @brief Removes a scratch database with its write-ahead logs
+ *
+ * @param name Database name without the .dat extension
+ */
+static void removeCheckFiles(const string& name) {
+    remove((name + ".dat").c_str());
+    remove((name + ".wal").c_str());
+    remove((name + ".wal.prev").c_str());
+}
+
+static bool fileExists(const string& path) {
+    return access(path.c_str(), F_OK) == 0;
+}
+
+/**
+ * @brief Runs 'crash' in a child process that exits without destructors
+ *
+ * Simulates a crash: nothing the database would do on a clean shutdown
+ * (final checkpoint, log truncation) happens, provided 'crash' leaves its
+ * database undeleted.
+ *
+ * @param crash Work of the child; its return value is the exit status
+ * @return bool True if the child ran and returned 0
+ */
+template <typename Work>
+static bool runAndCrash(Work crash) {
+    cout.flush();
+    pid_t child = fork();
+    if (child < 0) {
+        return false;
+    }
+    if (child == 0) {
+        int status = crash();
+        cout.flush();
+        _exit(status);
+    }
+    int status = 0;
+    if (waitpid(child, &status, 0) != child) {
+        return false;
+    }
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+/**
+ * @brief Changes logged but never checkpointed are replayed on reopen
+ *
+ * Covers adds, ID changes, removals and readings in the current log, and
+ * a retired log (.wal.prev) left by an unfinished background snapshot,
+ * which is replayed first and then folded into the snapshot.
+ */
+static void checkLogReplay() {
+    cout << "\n=== WRITE-AHEAD LOG REPLAY CHECK ===" << endl;
+    const string name = "check_replay";
+    removeCheckFiles(name);
+
+    bool crashed = runAndCrash([&name]() {
+        // Never deleted: the crash skips its destructor
+        SensorDatabase* db = new SensorDatabase(name.c_str());
+        for (u_int32_t id = 40001; id <= 40010; id++) {
+            db->addSensor(new TemperatureSensor(id));
+        }
+        db->changeSensorId(db->findSensorById(40005), 40100);
+        db->removeSensor(db->findSensorById(40010));
+        Sensor* sampled = db->findSensorById(40001);
+        sampled->setSingleData(123);
+        db->recordReading(sampled);
+        return db->commitLog(true) ? 0 : 1;
+    });
+    expect(crashed, "changes committed to the log before the crash");
+
+    struct stat logInfo;
+    expect(stat((name + ".wal").c_str(), &logInfo) == 0 && 
+           logInfo.st_size > 0, "changes are only in the log");
+    {
+        SensorDatabase db(name.c_str());
+        bool added = true;
+        for (u_int32_t id = 40001; id <= 40009; id++) {
+            if (id != 40005 && !db.findSensorById(id)) {
+                added = false;
+            }
+        }
+        expect(added, "added sensors replayed");
+        expect(!db.findSensorById(40005) && db.findSensorById(40100), 
+               "ID change replayed");
+        expect(!db.findSensorById(40010), "removal replayed");
+        expect(db.findSensorById(40001) && 
+               db.findSensorById(40001)->getSingleData() == 123, 
+               "reading replayed");
+    }
+    removeCheckFiles(name);
+
+    // Retired log: older changes in .wal.prev, newer ones in .wal
+    const string retiredName = "check_retired";
+    removeCheckFiles(retiredName);
+    string dataFile = retiredName + ".dat";
+    {
+        WriteAheadLog log(WriteAheadLog::logPathFor(dataFile.c_str()), 
+                          sizeof(SensorRecord));
+        TemperatureSensor first(40001);
+        TemperatureSensor second(40002);
+        TemperatureSensor third(40003);
+        SensorRecord record = SensorFactory::sensorToRecord(&first);
+        log.append(WriteAheadLog::ADD, 40001, &record);
+        record = SensorFactory::sensorToRecord(&second);
+        log.append(WriteAheadLog::ADD, 40002, &record);
+        log.commit();
+        expect(log.rotate(), "log retired to " + log.retiredPath());
+
+        second.setSensorId(40200);
+        record = SensorFactory::sensorToRecord(&second);
+        log.append(WriteAheadLog::UPDATE, 40002, &record);
+        record = SensorFactory::sensorToRecord(&third);
+        log.append(WriteAheadLog::ADD, 40003, &record);
+        log.commit();
+    }
+    {
+        SensorDatabase db(retiredName.c_str());
+        expect(db.findSensorById(40001) != nullptr, 
+               "sensor only in the retired log replayed");
+        expect(!db.findSensorById(40002) && db.findSensorById(40200), 
+               "current log replayed after the retired one");
+        expect(db.findSensorById(40003) != nullptr, 
+               "sensor only in the current log replayed");
+    }
+    expect(!fileExists(retiredName + ".wal.prev"), 
+           "retired log folded into the snapshot");
+    {
+        SensorDatabase db(retiredName.c_str());
+        expect(db.findSensorById(40001) && db.findSensorById(40200) && 
+               db.findSensorById(40003), "replayed sensors kept on reload");
+    }
+    removeCheckFiles(retiredName);
+}
+
+/**
+ * @brief Fixed-record files tombstone removed slots and reuse them
+ */
+static void checkSlotReuse() {
+    cout << "\n=== RECORD SLOT REUSE CHECK ===" << endl;
+    const string name = "check_slots";
+    const string dataFile = name + ".dat";
+    removeCheckFiles(name);
+    {
+        SensorDatabase db(name.c_str());
+        expect(db.setFileFormat(SensorFileFormat::FIXED_RECORDS), 
+               "switched to fixed records");
+        for (u_int32_t id = 40001; id <= 40005; id++) {
+            db.addSensor(new TemperatureSensor(id));
+        }
+        expect(db.checkpoint(), "checkpoint written");
+
+        SensorFileView view;
+        expect(view.open(dataFile.c_str()), "file opened");
+        size_t records = view.recordCount();
+        const SensorRecord* stored = view.findRecord(40003);
+        expect(stored != nullptr, "sensor has a record");
+        size_t slot = stored ? static_cast<size_t>(stored - view.begin()) : 0;
+        view.close();
+
+        db.removeSensor(db.findSensorById(40003));
+        expect(db.checkpoint(), "checkpoint after removal");
+        expect(view.open(dataFile.c_str()), "file reopened");
+        expect(view.recordCount() == records, "record count unchanged");
+        expect(slot < view.recordCount() && 
+               SensorFactory::isTombstone(view[slot]), 
+               "removed record tombstoned in place");
+        expect(view.findRecord(40003) == nullptr, "removed sensor not found");
+        view.close();
+
+        db.addSensor(new TemperatureSensor(40006));
+        expect(db.checkpoint(), "checkpoint after add");
+        expect(view.open(dataFile.c_str()), "file reopened");
+        expect(view.recordCount() == records, "file did not grow");
+        expect(view.findRecord(40006) == view.begin() + slot, 
+               "new sensor reuses the tombstoned slot");
+        view.close();
+    }
+    {
+        SensorDatabase db(name.c_str());
+        expect(!db.findSensorById(40003) && db.findSensorById(40006) && 
+               db.findSensorById(40005), "reload skips tombstones");
+    }
+    removeCheckFiles(name);
+}
+
+/**
+ * @brief applyBatch applies every operation or none
+ *
+ * A batch with one invalid operation leaves the table, the batch and the
+ * membership version untouched. A valid batch whose checkpoint cannot be
+ * written is still applied, and its changes survive a crash in the log.
+ */
+static void checkBatchAllOrNothing() {
+    cout << "\n=== BATCH ALL-OR-NOTHING CHECK ===" << endl;
+    const string name = "check_batch";
+    removeCheckFiles(name);
+    {
+        SensorDatabase db(name.c_str());
+        db.addSensor(new TemperatureSensor(40001));
+        size_t count = db.getSensorCount();
+        u_int64_t version = db.getMembershipVersion();
+
+        SensorBatch batch;
+        batch.add(new TemperatureSensor(40002));
+        batch.changeId(40001, 40003);
+        batch.remove(40999);    // Missing: the whole batch is rejected
+        bool rejected = false;
+        try {
+            db.applyBatch(batch);
+        } catch (const runtime_error&) {
+            rejected = true;
+        }
+        expect(rejected, "batch with a missing sensor rejected");
+        expect(db.getSensorCount() == count && !db.findSensorById(40002), 
+               "add not applied");
+        expect(db.findSensorById(40001) && !db.findSensorById(40003), 
+               "ID change not applied");
+        expect(batch.size() == 3, "batch kept");
+        expect(db.getMembershipVersion() == version, 
+               "membership version unchanged");
+
+        SensorBatch duplicate;
+        duplicate.add(new TemperatureSensor(40001));
+        rejected = false;
+        try {
+            db.applyBatch(duplicate);
+        } catch (const runtime_error&) {
+            rejected = true;
+        }
+        expect(rejected && db.getSensorCount() == count, 
+               "add of an ID in use rejected");
+    }
+    removeCheckFiles(name);
+
+    // Large batch (folded into a checkpoint) whose file cannot be written
+    const string failName = "check_batch_fail";
+    const string dataFile = failName + ".dat";
+    const u_int32_t first = 40001;
+    const u_int32_t added = 2 * WriteAheadLog::DEFAULT_GROUP_SIZE;
+    removeCheckFiles(failName);
+    bool crashed = runAndCrash([&]() {
+        SensorDatabase* db = new SensorDatabase(failName.c_str());
+        size_t count = db->getSensorCount();
+        remove(dataFile.c_str());
+        if (mkdir(dataFile.c_str(), 0755) != 0) {
+            return 2;
+        }
+        SensorBatch batch;
+        for (u_int32_t id = first; id < first + added; id++) {
+            batch.add(new TemperatureSensor(id));
+        }
+        if (db->applyBatch(batch) != added || 
+            db->getSensorCount() != count + added) {
+            return 3;
+        }
+        return db->commitLog(true) ? 0 : 4;
+    });
+    expect(crashed, "batch applied although its checkpoint failed");
+    rmdir(dataFile.c_str());
+    {
+        SensorDatabase db(failName.c_str());
+        bool recovered = true;
+        for (u_int32_t id = first; id < first + added; id++) {
+            if (!db.findSensorById(id)) {
+                recovered = false;
+            }
+        }
+        expect(recovered, "batch recovered from the log after the crash");
+    }
+    removeCheckFiles(failName);
+}
+
+/**
+ * @brief History range queries return exactly the samples in [from, to]
+ */
+static void checkHistoryRange() {
+    cout << "\n=== READING HISTORY RANGE CHECK ===" << endl;
+    ReadingHistory history;
+    TemperatureSensor sensor(40001);
+    const int samples = 300;    // Several chunks
+    for (int i = 0; i < samples; i++) {
+        sensor.setSingleData(i * 3 - 50);
+        history.record(&sensor, 1000 + i * 10);
+    }
+    expect(history.sampleCount(40001) == static_cast<size_t>(samples), 
+           "every sample kept");
+
+    // [1100, 2500] holds samples 10..150, both ends included
+    int expected = 10;
+    bool exact = true;
+    for (const ReadingHistory::Sample& s : history.range(40001, 1100, 2500)) {
+        if (s.timestamp != 1000 + expected * 10 || 
+            s.values[0] != expected * 3 - 50) {
+            exact = false;
+        }
+        expected++;
+    }
+    expect(exact && expected == 151, "range holds samples 10 to 150");
+
+    size_t all = 0;
+    for (const ReadingHistory::Sample& s : history.range(40001, 0, 100000)) {
+        (void)s;
+        all++;
+    }
+    expect(all == static_cast<size_t>(samples), "wide range holds all");
+    expect(history.range(40001, 1001, 1009).empty(), 
+           "range between two samples is empty");
+    expect(history.range(40001, 2500, 1100).empty(), "inverted range empty");
+    expect(history.range(40002, 0, 100000).empty(), "unknown sensor empty");
+
+    history.rekey(40001, 40002);
+    expect(history.range(40001, 0, 100000).empty() && 
+           history.sampleCount(40002) == static_cast<size_t>(samples), 
+           "series follows an ID change");
+    history.forget(40002);
+    expect(history.sampleCount(40002) == 0, "series dropped on removal");
+}
+
+/**
+ * @brief getSensorsInIdRange includes both ends and handles edge IDs
+ */
+static void checkIdRange() {
+    cout << "\n=== ID RANGE CHECK ===" << endl;
+    const string name = "check_range";
+    removeCheckFiles(name);
+    {
+        SensorDatabase db(name.c_str());
+        db.addSensor(new AirQualitySensor(20001));
+        db.addSensor(new AirQualitySensor(20005));
+        db.addSensor(new AirQualitySensor(20009));
+
+        SensorIdRange range = db.getSensorsInIdRange(20001, 20009);
+        expect(range.size() == 3 && range[0]->getSensorId() == 20001 && 
+               range[2]->getSensorId() == 20009, "both ends included");
+        expect(db.getSensorsInIdRange(20002, 20004).empty(), 
+               "range without sensors empty");
+        range = db.getSensorsInIdRange(20005, 20005);
+        expect(range.size() == 1 && range[0]->getSensorId() == 20005, 
+               "single-ID range");
+        expect(db.getSensorsInIdRange(20009, 20001).empty(), 
+               "inverted range empty");
+
+        range = db.getSensorsInIdRange(0, Sensor::MIN_SENSOR_ID);
+        expect(range.size() == 1 && 
+               range[0]->getSensorId() == Sensor::MIN_SENSOR_ID, 
+               "range up to the lowest ID");
+        expect(db.getSensorsInIdRange(Sensor::MAX_SENSOR_ID, 
+                                      0xFFFFFFFF).empty(), 
+               "range past the highest ID");
+        expect(db.getSensorsInIdRange(0, 0xFFFFFFFF).size() == 
+               db.getSensorCount(), "full range holds every sensor");
+
+        u_int32_t previous = 0;
+        bool ascending = true;
+        for (Sensor* sensor : db.getSensorsInIdRange(20000, 29999)) {
+            if (sensor->getSensorId() <= previous) {
+                ascending = false;
+            }
+            previous = sensor->getSensorId();
+        }
+        expect(ascending, "range in ascending ID order");
+    }
+    removeCheckFiles(name);
+}
+
+/**
+ * @brief provision takes the lowest free IDs of each manifest range
+ */
+static void checkProvision() {
+    cout << "\n=== PROVISION CHECK ===" << endl;
+    const string name = "check_provision";
+    removeCheckFiles(name);
+    {
+        SensorDatabase db(name.c_str());
+        db.addSensor(new TemperatureSensor(40001));
+        db.addSensor(new TemperatureSensor(40003));
+
+        SensorManifest manifest;
+        manifest.addEntry(Sensor::TEMPERATURE, 3, 40000, 40010);
+        expect(db.provision(manifest) == 3, "three sensors provisioned");
+        expect(db.findSensorById(40002) && db.findSensorById(40004) && 
+               db.findSensorById(40005), "lowest free IDs taken");
+        expect(!db.findSensorById(40006), "no ID past the last needed");
+        Sensor* sensor = db.findSensorById(40002);
+        expect(sensor && sensor->getType() == Sensor::TEMPERATURE, 
+               "sensors of the manifest type");
+
+        // 40006-40010 are the only free IDs left in the range
+        size_t count = db.getSensorCount();
+        SensorManifest tooMany;
+        tooMany.addEntry(Sensor::TEMPERATURE, 6, 40000, 40010);
+        bool rejected = false;
+        try {
+            db.provision(tooMany);
+        } catch (const runtime_error&) {
+            rejected = true;
+        }
+        expect(rejected, "manifest with too few free IDs rejected");
+        expect(db.getSensorCount() == count && !db.findSensorById(40006), 
+               "nothing provisioned");
+    }
+    removeCheckFiles(name);
+}
+
+/**
+ * @brief getMembershipChanges lists recent changes and reports overflow
+ */
+static void checkMembershipChanges() {
+    cout << "\n=== MEMBERSHIP CHANGES CHECK ===" << endl;
+    const string name = "check_membership";
+    removeCheckFiles(name);
+    {
+        SensorDatabase db(name.c_str());
+        u_int64_t since = db.getMembershipVersion();
+        db.addSensor(new TemperatureSensor(40001));
+        db.changeSensorId(db.findSensorById(40001), 40002);
+
+        vector<u_int32_t> ids;  // Appended to by getMembershipChanges
+        bool listed = db.getMembershipChanges(since, ids);
+        bool hasOld = false;
+        bool hasNew = false;
+        for (u_int32_t id : ids) {
+            hasOld = hasOld || id == 40001;
+            hasNew = hasNew || id == 40002;
+        }
+        expect(listed && hasOld && hasNew, "recent changes listed");
+        ids.clear();
+        expect(db.getMembershipChanges(db.getMembershipVersion(), ids) && 
+               ids.empty(), "no changes since the current version");
+
+        // More changes than the log keeps: the caller must rescan
+        SensorBatch batch;
+        for (u_int32_t id = 40100; id < 45100; id++) {
+            batch.add(new TemperatureSensor(id));
+        }
+        db.applyBatch(batch);
+        expect(!db.getMembershipChanges(since, ids), 
+               "overflowed log asks for a rescan");
+        ids.clear();
+        expect(db.getMembershipChanges(db.getMembershipVersion(), ids) && 
+               ids.empty(), "current version still followed");
+    }
+    removeCheckFiles(name);
+}
+
+/**
+ * @brief Runs every automated behavior check
+ *
+ * @return int Number of failed expectations (0 if all passed)
+ */
+int runChecks() {
+    checksFailed = 0;
+    checkLogReplay();
+    checkSlotReuse();
+    checkBatchAllOrNothing();
+    checkHistoryRange();
+    checkIdRange();
+    checkProvision();
+    checkMembershipChanges();
+
+    cout << "\n" << (checksFailed == 0 ? "All checks passed" 
+                                       : "Some checks FAILED") 
+         << " (" << checksFailed << " failure(s))" << endl;
+    return checksFailed;
+}
@@ -166,7 +166,7 @@ void displayMenu() {
 void displayUserList(const UserDatabase& db) {
     cout << "\n=== User List ===" << endl;
     
-    set<User*> users = db.getAllUsers();
+    const set<User*>& users = db.getAllUsers();
     if (users.empty()) {
         cout << "No users found in the database." << endl;
         return;
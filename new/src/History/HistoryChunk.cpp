@@ -0,0 +1,118 @@
+#include "HistoryChunk.h"
+
+using namespace std;
+
+namespace {
+    void putVarint(uint64_t value, vector<unsigned char>& out) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<unsigned char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<unsigned char>(value));
+    }
+
+    size_t varintLength(uint64_t value) {
+        size_t length = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            length++;
+        }
+        return length;
+    }
+
+    uint64_t getVarint(const vector<unsigned char>& in, size_t& offset) {
+        uint64_t value = 0;
+        for (int shift = 0; offset < in.size(); shift += 7) {
+            unsigned char byte = in[offset++];
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                break;
+            }
+        }
+        return value;
+    }
+
+    uint64_t zigzag(int64_t value) {
+        return (static_cast<uint64_t>(value) << 1) ^
+               static_cast<uint64_t>(value >> 63);
+    }
+
+    int64_t unzigzag(uint64_t value) {
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+}
+
+HistoryChunk::HistoryChunk(size_t capacity, size_t width,
+                           ValueEncoding encoding)
+    : capacityBytes(capacity), valueWidth(width), encoding(encoding),
+      count(0), firstTime(0), lastTime(0), lastDelta(0),
+      lastValues(width, 0) {
+    bytes.reserve(capacity);
+}
+
+// The encoded size is worked out first, so a sample that does not fit
+// never grows 'bytes' past the capacity it reserved
+bool HistoryChunk::append(int64_t timestamp, const int* values) {
+    int64_t previousTime = (count == 0) ? timestamp : lastTime;
+    int64_t delta = timestamp - previousTime;
+    uint64_t timeCode = zigzag(delta - lastDelta);
+
+    size_t needed = varintLength(timeCode);
+    for (size_t i = 0; i < valueWidth; i++) {
+        needed += varintLength(encodeValue(values[i], lastValues[i]));
+    }
+    if (bytes.size() + needed > capacityBytes) {
+        return false; // Does not fit: the caller starts a new chunk
+    }
+
+    putVarint(timeCode, bytes);
+    for (size_t i = 0; i < valueWidth; i++) {
+        putVarint(encodeValue(values[i], lastValues[i]), bytes);
+    }
+
+    if (count == 0) {
+        firstTime = timestamp;
+    }
+    lastDelta = delta;
+    lastTime = timestamp;
+    lastValues.assign(values, values + valueWidth);
+    count++;
+    return true;
+}
+
+uint64_t HistoryChunk::encodeValue(int value, int previous) const {
+    if (encoding == DELTA) {
+        return zigzag(static_cast<int64_t>(value) - previous);
+    }
+    return static_cast<uint32_t>(value) ^ static_cast<uint32_t>(previous);
+}
+
+HistoryChunk::Cursor::Cursor(const HistoryChunk* chunk)
+    : chunk(chunk), offset(0), decoded(0), time(0), delta(0),
+      current(chunk ? chunk->valueWidth : 0, 0) {
+    if (chunk) {
+        time = chunk->firstTime;
+    }
+}
+
+bool HistoryChunk::Cursor::next() {
+    if (!chunk || decoded >= chunk->count) {
+        return false;
+    }
+
+    delta += unzigzag(getVarint(chunk->bytes, offset));
+    time += delta;
+
+    for (size_t i = 0; i < chunk->valueWidth; i++) {
+        uint64_t encoded = getVarint(chunk->bytes, offset);
+        if (chunk->encoding == DELTA) {
+            current[i] = static_cast<int>(current[i] + unzigzag(encoded));
+        } else {
+            current[i] = static_cast<int>(static_cast<uint32_t>(current[i]) ^
+                                          static_cast<uint32_t>(encoded));
+        }
+    }
+
+    decoded++;
+    return true;
+}
@@ -0,0 +1,78 @@
+#ifndef HISTORYCHUNK_H
+#define HISTORYCHUNK_H
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Fixed-size, append-only block of encoded samples
+ *
+ * A sample is a timestamp (milliseconds) plus 'width' int values: one for
+ * scalar sensors, a whole frame for cameras. Samples are packed as varints:
+ *
+ *  - timestamp: zigzag delta-of-delta, one byte for a steady cadence
+ *  - values:    DELTA  -> zigzag(value - previous value), for scalars
+ *               XOR    -> value ^ previous value, for camera frames
+ *
+ * The encoder state restarts at every chunk, so each chunk decodes on its
+ * own and the oldest chunk can be dropped without touching the others.
+ */
+class HistoryChunk {
+public:
+    enum ValueEncoding {
+        DELTA,
+        XOR
+    };
+
+    HistoryChunk(size_t capacity, size_t width, ValueEncoding encoding);
+
+    // Append a sample; returns false (and leaves the chunk as it was) if
+    // the encoded sample does not fit in the remaining capacity
+    bool append(int64_t timestamp, const int* values);
+
+    size_t sampleCount() const { return count; }
+    size_t bytesUsed() const { return bytes.size(); }
+    size_t capacity() const { return capacityBytes; }
+    size_t reservedBytes() const { return bytes.capacity(); } // Allocated
+    size_t width() const { return valueWidth; }
+    int64_t firstTimestamp() const { return firstTime; }
+    int64_t lastTimestamp() const { return lastTime; }
+
+    // Sequential decoder over the samples of one chunk
+    class Cursor {
+    public:
+        explicit Cursor(const HistoryChunk* chunk = nullptr);
+
+        // Decode the next sample; returns false at the end of the chunk
+        bool next();
+        int64_t timestamp() const { return time; }
+        const int* values() const { return current.data(); }
+
+    private:
+        const HistoryChunk* chunk;
+        size_t offset;
+        size_t decoded;
+        int64_t time;
+        int64_t delta;
+        std::vector<int> current;
+    };
+
+private:
+    uint64_t encodeValue(int value, int previous) const;
+
+    size_t capacityBytes;
+    size_t valueWidth;
+    ValueEncoding encoding;
+
+    std::vector<unsigned char> bytes;  // Reserved to 'capacityBytes'
+    size_t count;
+    int64_t firstTime;
+
+    // Encoder state (the decoder rebuilds the same sequence)
+    int64_t lastTime;
+    int64_t lastDelta;
+    std::vector<int> lastValues;
+};
+
+#endif // HISTORYCHUNK_H
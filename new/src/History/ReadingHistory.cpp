@@ -0,0 +1,194 @@
+#include "ReadingHistory.h"
+#include <chrono>
+
+using namespace std;
+
+// Out-of-line definitions for the ODR-used constants
+constexpr size_t ReadingHistory::SCALAR_CHUNK_BYTES;
+constexpr size_t ReadingHistory::FRAME_CHUNK_BYTES;
+constexpr size_t ReadingHistory::DEFAULT_MAX_CHUNKS;
+
+ReadingHistory::ReadingHistory(size_t maxChunks)
+    : maxChunks(maxChunks == 0 ? 1 : maxChunks) {
+}
+
+void ReadingHistory::record(const Sensor* sensor, int64_t timestamp) {
+    if (!sensor) {
+        throw invalid_argument("Cannot record history of null sensor");
+    }
+
+    if (isFrameSensor(sensor)) {
+        append(frameSeries[sensor->getSensorId()], FRAME_CHUNK_BYTES,
+               Sensor::MAX_DATA_SIZE, HistoryChunk::XOR, timestamp,
+               sensor->getFullData());
+    } else {
+        append(scalarSeries[sensor->getSensorId()], SCALAR_CHUNK_BYTES, 1,
+               HistoryChunk::DELTA, timestamp, sensor->getFullData());
+    }
+}
+
+void ReadingHistory::append(Series& series, size_t chunkBytes, size_t width,
+                            HistoryChunk::ValueEncoding encoding,
+                            int64_t timestamp, const int* values) {
+    if (!series.empty() && series.back().append(timestamp, values)) {
+        return;
+    }
+
+    // Current chunk is full (or the series is new): open the next one and
+    // drop the oldest once the retention limit is reached
+    series.push_back(HistoryChunk(chunkBytes, width, encoding));
+    if (series.size() > maxChunks) {
+        series.pop_front();
+    }
+    series.back().append(timestamp, values);
+}
+
+void ReadingHistory::forget(u_int32_t sensorId) {
+    scalarSeries.erase(sensorId);
+    frameSeries.erase(sensorId);
+}
+
+void ReadingHistory::rekey(u_int32_t oldSensorId, u_int32_t newSensorId) {
+    SeriesMap* maps[] = { &scalarSeries, &frameSeries };
+    for (SeriesMap* map : maps) {
+        auto it = map->find(oldSensorId);
+        if (it != map->end()) {
+            (*map)[newSensorId].swap(it->second);
+            map->erase(oldSensorId);
+        }
+    }
+}
+
+ReadingHistory::Range ReadingHistory::range(u_int32_t sensorId, int64_t from,
+                                             int64_t to) const {
+    return Range(findSeries(sensorId), from, to);
+}
+
+size_t ReadingHistory::sampleCount(u_int32_t sensorId) const {
+    const Series* series = findSeries(sensorId);
+    size_t total = 0;
+    if (series) {
+        for (const HistoryChunk& chunk : *series) {
+            total += chunk.sampleCount();
+        }
+    }
+    return total;
+}
+
+// Chunk storage allocated for every series
+size_t ReadingHistory::memoryBytes() const {
+    size_t total = 0;
+    const SeriesMap* maps[] = { &scalarSeries, &frameSeries };
+    for (const SeriesMap* map : maps) {
+        for (const auto& entry : *map) {
+            for (const HistoryChunk& chunk : entry.second) {
+                total += chunk.reservedBytes();
+            }
+        }
+    }
+    return total;
+}
+
+int64_t ReadingHistory::now() {
+    return chrono::duration_cast<chrono::milliseconds>(
+        chrono::system_clock::now().time_since_epoch()).count();
+}
+
+bool ReadingHistory::isFrameSensor(const Sensor* sensor) {
+    return sensor->getType() == Sensor::THERMAL_CAMERA ||
+           sensor->getType() == Sensor::RGB_CAMERA;
+}
+
+const ReadingHistory::Series* ReadingHistory::findSeries(
+        u_int32_t sensorId) const {
+    auto scalar = scalarSeries.find(sensorId);
+    auto frame = frameSeries.find(sensorId);
+    const Series* scalars = (scalar != scalarSeries.end()) ? &scalar->second
+                                                           : nullptr;
+    const Series* frames = (frame != frameSeries.end()) ? &frame->second
+                                                        : nullptr;
+    if (!scalars || !frames) {
+        return scalars ? scalars : frames;
+    }
+
+    // A sensor that changed between scalar and camera types has both: its
+    // current type is the one written last
+    return (frames->back().lastTimestamp() > scalars->back().lastTimestamp())
+           ? frames : scalars;
+}
+
+// === Iterator ===
+
+ReadingHistory::Iterator::Iterator()
+    : series(nullptr), chunkIndex(0), from(0), to(0) {
+    sample.timestamp = 0;
+    sample.values = nullptr;
+    sample.width = 0;
+}
+
+ReadingHistory::Iterator::Iterator(const Series* series, int64_t from,
+                                   int64_t to)
+    : series(series), chunkIndex(0), from(from), to(to) {
+    sample.timestamp = 0;
+    sample.values = nullptr;
+    sample.width = 0;
+
+    if (!series) {
+        return;
+    }
+
+    // Skip whole chunks that end before the range starts
+    while (chunkIndex < series->size() &&
+           (*series)[chunkIndex].lastTimestamp() < from) {
+        chunkIndex++;
+    }
+    if (chunkIndex == series->size()) {
+        this->series = nullptr;
+        return;
+    }
+
+    cursor = HistoryChunk::Cursor(&(*series)[chunkIndex]);
+    advance();
+}
+
+const ReadingHistory::Sample& ReadingHistory::Iterator::operator*() const {
+    sample.values = cursor.values(); // The cursor may have been copied
+    return sample;
+}
+
+ReadingHistory::Iterator& ReadingHistory::Iterator::operator++() {
+    advance();
+    return *this;
+}
+
+bool ReadingHistory::Iterator::operator==(const Iterator& other) const {
+    if (!series || !other.series) {
+        return series == other.series;
+    }
+    return series == other.series && chunkIndex == other.chunkIndex &&
+           sample.timestamp == other.sample.timestamp;
+}
+
+void ReadingHistory::Iterator::advance() {
+    while (series) {
+        if (cursor.next()) {
+            if (cursor.timestamp() < from) {
+                continue;
+            }
+            if (cursor.timestamp() > to) {
+                series = nullptr; // Past the range: chunks are in time order
+                return;
+            }
+            sample.timestamp = cursor.timestamp();
+            sample.values = cursor.values();
+            sample.width = (*series)[chunkIndex].width();
+            return;
+        }
+
+        if (++chunkIndex == series->size()) {
+            series = nullptr;
+            return;
+        }
+        cursor = HistoryChunk::Cursor(&(*series)[chunkIndex]);
+    }
+}
@@ -0,0 +1,118 @@
+#ifndef READINGHISTORY_H
+#define READINGHISTORY_H
+
+#include <deque>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include "HistoryChunk.h"
+#include "../Sensors/Sensor.h"
+
+/**
+ * @brief In-memory, append-only history of sensor readings
+ *
+ * Every sensor gets its own series of fixed-size HistoryChunks. Scalar
+ * readings and camera frames live in separate streams with their own
+ * chunk size and value encoding (delta for scalars, XOR for frames).
+ *
+ * Retention is bounded per series: once a series holds 'maxChunks' chunks
+ * the oldest one is dropped, so memory stays flat however long the
+ * collection loop runs (at most maxChunks * chunk size per sensor).
+ *
+ * Usage:
+ *     history.record(sensor, ReadingHistory::now());
+ *     for (const ReadingHistory::Sample& s : history.range(id, from, to)) {
+ *         ... s.timestamp, s.values[0] ...
+ *     }
+ */
+class ReadingHistory {
+public:
+    static constexpr size_t SCALAR_CHUNK_BYTES = 256;
+    static constexpr size_t FRAME_CHUNK_BYTES = 8192;
+    static constexpr size_t DEFAULT_MAX_CHUNKS = 16;  // Per sensor
+
+    // One decoded sample; 'values' is only valid until the iterator moves
+    struct Sample {
+        int64_t timestamp;   // Milliseconds since the epoch
+        const int* values;
+        size_t width;        // 1 for scalars, frame size for cameras
+    };
+
+private:
+    typedef std::deque<HistoryChunk> Series;
+
+public:
+    // Forward iterator over the samples of one series inside [from, to]
+    class Iterator {
+    public:
+        Iterator();
+        Iterator(const Series* series, int64_t from, int64_t to);
+
+        const Sample& operator*() const;
+        const Sample* operator->() const { return &**this; }
+        Iterator& operator++();
+        bool operator==(const Iterator& other) const;
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        void advance();
+
+        const Series* series;
+        size_t chunkIndex;
+        HistoryChunk::Cursor cursor;
+        int64_t from;
+        int64_t to;
+        mutable Sample sample;
+    };
+
+    // Time-range view; invalidated by the next record() on the same sensor
+    class Range {
+    public:
+        Range(const Series* series, int64_t from, int64_t to)
+            : series(series), from(from), to(to) {}
+        Iterator begin() const { return Iterator(series, from, to); }
+        Iterator end() const { return Iterator(); }
+        bool empty() const { return !(begin() != end()); }
+
+    private:
+        const Series* series;
+        int64_t from;
+        int64_t to;
+    };
+
+    explicit ReadingHistory(size_t maxChunks = DEFAULT_MAX_CHUNKS);
+
+    // Append the current data of a sensor
+    void record(const Sensor* sensor, int64_t timestamp);
+
+    // Series maintenance (sensor removed / ID changed)
+    void forget(u_int32_t sensorId);
+    void rekey(u_int32_t oldSensorId, u_int32_t newSensorId);
+
+    // Readings of a sensor with from <= timestamp <= to
+    Range range(u_int32_t sensorId, int64_t from, int64_t to) const;
+
+    // Statistics
+    size_t sampleCount(u_int32_t sensorId) const;
+    size_t memoryBytes() const;
+    size_t seriesCount() const { return scalarSeries.size() + frameSeries.size(); }
+
+    // Wall-clock timestamp in milliseconds
+    static int64_t now();
+
+private:
+    typedef std::unordered_map<u_int32_t, Series> SeriesMap;
+
+    static bool isFrameSensor(const Sensor* sensor);
+    const Series* findSeries(u_int32_t sensorId) const;
+    void append(Series& series, size_t chunkBytes, size_t width,
+                HistoryChunk::ValueEncoding encoding, int64_t timestamp,
+                const int* values);
+
+    size_t maxChunks;
+    SeriesMap scalarSeries;  // Scalar readings, DELTA-encoded
+    SeriesMap frameSeries;   // Camera frames, XOR-encoded
+};
+
+#endif // READINGHISTORY_H
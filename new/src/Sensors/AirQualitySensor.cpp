@@ -1,7 +1,6 @@
 #include "AirQualitySensor.h"
+#include "../Utils/CounterRandom.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 
 using namespace std;
 
@@ -11,6 +10,11 @@ AirQualitySensor::AirQualitySensor(u_int32_t sensorId)
     collectData();
 }
 
+// Same, without the initial reading (bulk provisioning)
+AirQualitySensor::AirQualitySensor(u_int32_t sensorId, Unsampled) 
+    : Sensor(sensorId, Type::AIR_QUALITY) {
+}
+
 AirQualitySensor* AirQualitySensor::createPrimary() {
     cout << "[SYSTEM] Loading PRIMARY AirQualitySensor (ID=" 
          << PRIMARY_AIR_QUALITY_ID << ")" << endl;
@@ -19,7 +23,26 @@ AirQualitySensor* AirQualitySensor::createPrimary() {
 
 // Implementation of pure virtual method collectData
 void AirQualitySensor::collectData() {
-    readAirQualityFromHardware();
+    readFromHardware();
+}
+
+// Simulated air quality in ppm: 0-400 plus variance (-10 to +10), capped
+// to 0-500
+void AirQualitySensor::simulateReadings(const u_int32_t* streams, int* out, 
+                                        size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int reading = CounterRandom::uniform(streams[i], 0, 401) + 
+                      CounterRandom::uniform(streams[i], 1, 21) - 10;
+        out[i] = reading < 0 ? 0 : (reading > 500 ? 500 : reading);
+    }
+}
+
+void AirQualitySensor::collectBatch(Sensor* const* sensors, size_t count) {
+    readBatchFromHardware(sensors, count);
+}
+
+Sensor* AirQualitySensor::clone() const {
+    return new AirQualitySensor(*this);
 }
 
 // Human-readable air quality interpretation
@@ -41,37 +64,6 @@ const char* AirQualitySensor::getAirQualityDescription() const {
     }
 }
 
-// Private method to simulate reading from hardware
-int AirQualitySensor::readAirQualityFromHardware() {
-    // Simulate air quality reading in ppm (parts per million)
-    // Good air quality: 0-50 ppm
-    // Moderate: 51-100 ppm  
-    // Unhealthy: 101-300 ppm
-    // Hazardous: 301+ ppm
-    
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        seeded = true;
-    }
-    
-    // Generate realistic air quality values (0-400 ppm)
-    int baseReading = rand() % 401; // 0-400
-    
-    // Add some realistic variance
-    int variance = (rand() % 21) - 10; // -10 to +10
-    int finalReading = baseReading + variance;
-    
-    // Ensure reading is within valid range
-    if (finalReading < 0) finalReading = 0;
-    if (finalReading > 500) finalReading = 500;
-    
-    // Set the sensor data
-    setSingleData(finalReading);
-    
-    return finalReading;
-}
-
 std::ostream& operator<<(std::ostream& os, const AirQualitySensor& sensor) {
     os << "Air Quality: " << sensor.getSingleData() << " ppm";
     os << " (" << sensor.getAirQualityDescription() << ")";
@@ -2,30 +2,36 @@
 #define AIRQUALITYSENSOR_H
 
 #include "Sensor.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class AirQualitySensor : public Sensor {
+class AirQualitySensor : public Sensor, public PoolAllocated<AirQualitySensor> {
 public:
     static constexpr u_int32_t PRIMARY_AIR_QUALITY_ID = 20000;
+    static constexpr Type SENSOR_TYPE = AIR_QUALITY;
 
     // Constructor - follows same pattern as User derived classes
     AirQualitySensor(u_int32_t sensorId);
+    AirQualitySensor(u_int32_t sensorId, Unsampled); // Takes no reading
 
     // Constructor 2: Primary sensor (ID=0)
     static AirQualitySensor* createPrimary();
 
     // Implement pure virtual method from Sensor
     void collectData() override;
+    Sensor* clone() const override;
+
+    // Simulated hardware (SimulatedHardware): one reading per stream into
+    // out[0, count), drawn from CounterRandom streams
+    static void simulateReadings(const u_int32_t* streams, int* out,
+                                 size_t count);
+    static void collectBatch(Sensor* const* sensors, size_t count); // Same type
     
     // Human-readable air quality interpretation
     const char* getAirQualityDescription() const;
 
     friend std::ostream& operator<<(std::ostream& os, const AirQualitySensor& sensor);
-
-private:
-    // Private method to simulate reading from hardware
-    int readAirQualityFromHardware();
 };
 
 #endif // AIRQUALITYSENSOR_H
\ No newline at end of file
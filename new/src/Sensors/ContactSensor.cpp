@@ -1,8 +1,7 @@
 #include "ContactSensor.h"
 #include "Coordination/SensorCoordinator.h" 
+#include "../Utils/CounterRandom.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 
 using namespace std;
 
@@ -12,6 +11,11 @@ ContactSensor::ContactSensor(u_int32_t sensorId)
     collectData();
 }
 
+// Same, without the initial reading (bulk provisioning)
+ContactSensor::ContactSensor(u_int32_t sensorId, Unsampled) 
+    : Sensor(sensorId, Type::CONTACT) {
+}
+
 ContactSensor* ContactSensor::createPrimary() {
     cout << "[SYSTEM] Loading PRIMARY ContactSensor (ID=" 
          << PRIMARY_CONTACT_ID << ")" << endl;
@@ -20,7 +24,35 @@ ContactSensor* ContactSensor::createPrimary() {
 
 // Implementation of pure virtual method collectData
 void ContactSensor::collectData() {
-    readContactFromHardware();
+    readFromHardware();
+
+    if (SensorCoordinator::isContactMaster(getSensorId())) {
+        SensorCoordinator::setMovementDetected(getSingleData() == 1);
+    }
+}
+
+// Simulated contact state: 1 = OPEN (movement detected) 30% of the time,
+// 0 = CLOSED otherwise
+void ContactSensor::simulateReadings(const u_int32_t* streams, int* out, 
+                                     size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        out[i] = CounterRandom::uniform(streams[i], 0, 100) < 30;
+    }
+}
+
+void ContactSensor::collectBatch(Sensor* const* sensors, size_t count) {
+    readBatchFromHardware(sensors, count);
+    
+    for (size_t i = 0; i < count; i++) {
+        if (SensorCoordinator::isContactMaster(sensors[i]->getSensorId())) {
+            SensorCoordinator::setMovementDetected(
+                sensors[i]->getSingleData() == 1);
+        }
+    }
+}
+
+Sensor* ContactSensor::clone() const {
+    return new ContactSensor(*this);
 }
 
 // Helper method to interpret contact state
@@ -33,32 +65,6 @@ const char* ContactSensor::getContactStateDescription() const {
     return isContactOpen() ? "OPEN" : "CLOSED";
 }
 
-// Private method to simulate reading from hardware
-int ContactSensor::readContactFromHardware() {
-    // Simulate contact sensor reading
-    // 0 = CLOSED (no movement)
-    // 1 = OPEN (movement detected)
-    
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        seeded = true;
-    }
-    
-    // Generate realistic contact patterns
-    // 70% chance closed, 30% chance open
-    int contactReading = (rand() % 100 < 30) ? 1 : 0;
-    
-    // Set the sensor data
-    setSingleData(contactReading);
-
-    if (SensorCoordinator::isContactMaster(getSensorId())) {
-        SensorCoordinator::setMovementDetected(contactReading == 1);
-    }
-    
-    return contactReading;
-}
-
 std::ostream& operator<<(std::ostream& os, const ContactSensor& sensor) {
     os << "Contact: " << sensor.getSingleData();
     os << " (" << sensor.getContactStateDescription();
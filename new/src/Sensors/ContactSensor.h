@@ -2,31 +2,37 @@
 #define CONTACTSENSOR_H
 
 #include "Sensor.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class ContactSensor : public Sensor {
+class ContactSensor : public Sensor, public PoolAllocated<ContactSensor> {
 public:
     static constexpr u_int32_t PRIMARY_CONTACT_ID = 50000;
+    static constexpr Type SENSOR_TYPE = CONTACT;
 
     // Constructor - follows same pattern as other derived classes
     ContactSensor(u_int32_t sensorId);
+    ContactSensor(u_int32_t sensorId, Unsampled); // Takes no reading
 
     // Constructor 2: Primary sensor (ID=0)
     static ContactSensor* createPrimary();
 
     // Implement pure virtual method from Sensor
     void collectData() override;
+    Sensor* clone() const override;
+
+    // Simulated hardware (SimulatedHardware): one reading per stream into
+    // out[0, count), drawn from CounterRandom streams
+    static void simulateReadings(const u_int32_t* streams, int* out,
+                                 size_t count);
+    static void collectBatch(Sensor* const* sensors, size_t count); // Same type
     
     // Helper method to interpret contact state
     const char* getContactStateDescription() const;
     bool isContactOpen() const;
 
     friend std::ostream& operator<<(std::ostream& os, const ContactSensor& sensor);
-
-private:
-    // Private method to simulate reading from hardware
-    int readContactFromHardware();
 };
 
 #endif // CONTACTSENSOR_H
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "CollectionEngine.h"
+#include "../Hygrometer.h"
+#include "../AirQualitySensor.h"
+#include "../LuxMeterSensor.h"
+#include "../TemperatureSensor.h"
+#include "../ContactSensor.h"
+#include "../ThermalCamera.h"
+#include "../RGBCamera.h"
+#include "../SensorFactory.h"
+#include "../../Databases/SensorDatabase.h"
+#include <chrono>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    // Phase 1 order: the masters first, every camera reads what they set
+    const u_int32_t PRIMARY_IDS[] = {
+        TemperatureSensor::PRIMARY_TEMP_ID,        // Master: temperature
+        ContactSensor::PRIMARY_CONTACT_ID,         // Master: movement
+        Hygrometer::PRIMARY_HYGRO_ID,
+        AirQualitySensor::PRIMARY_AIR_QUALITY_ID,
+        LuxMeterSensor::PRIMARY_LUX_ID,
+        ThermalCamera::PRIMARY_THERMAL_ID,
+        RGBCamera::PRIMARY_RGB_ID
+    };
+
+    // One batch call per stretch of non-primary sensors
+    void collectChunk(const CollectionEngine::TypeRun& chunk) {
+        size_t start = 0;
+        for (size_t i = 0; i < chunk.count; i++) {
+            if (chunk.sensors[i]->isPrimarySensor()) {
+                SensorFactory::collectBatch(chunk.type, chunk.sensors + start,
+                                            i - start);
+                start = i + 1;
+            }
+        }
+        SensorFactory::collectBatch(chunk.type, chunk.sensors + start,
+                                    chunk.count - start);
+    }
+
+    double elapsedMs(chrono::steady_clock::time_point since) {
+        return chrono::duration<double, milli>(
+            chrono::steady_clock::now() - since).count();
+    }
+}
+
+CollectionEngine::CollectionEngine(SensorDatabase& db, unsigned threads)
+    : db(db), pool(threads), cycles(0) {
+    lastCycle = CycleStats{0, 0, pool.getThreadCount(), 0.0, 0.0, 0.0, 0.0};
+}
+
+const CollectionEngine::CycleStats& CollectionEngine::runCycle() {
+    EpochReclaimer::Guard guard(db.getReclaimer());
+    const vector<Sensor*>& sensors = db.getAllSensors();
+    CycleStats stats = {sensors.size(), 0, pool.getThreadCount(),
+                        0.0, 0.0, 0.0, 0.0};
+    auto start = chrono::steady_clock::now();
+
+    // Phase 1: primaries, masters first
+    for (u_int32_t sensorId : PRIMARY_IDS) {
+        Sensor* sensor = db.findSensorById(sensorId);
+        if (sensor) {
+            sensor->collectData();
+            stats.primaries++;
+        }
+    }
+    stats.primaryMs = elapsedMs(start);
+
+    // Phase 2: everything else, which only reads the coordinator state
+    auto phase = chrono::steady_clock::now();
+    vector<TypeRun> runs;
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        const vector<Sensor*>& list = 
+            db.getSensorsOfType(static_cast<Sensor::Type>(type));
+        runs.push_back(TypeRun{static_cast<Sensor::Type>(type), 
+                               list.data(), list.size()});
+    }
+    collectRuns(pool, runs);
+    stats.parallelMs = elapsedMs(phase);
+
+    // Single-threaded again: the database itself is not thread-safe
+    phase = chrono::steady_clock::now();
+    db.recordReadings(sensors);
+    stats.recordMs = elapsedMs(phase);
+
+    stats.totalMs = elapsedMs(start);
+    lastCycle = stats;
+    cycles++;
+    return lastCycle;
+}
+
+void CollectionEngine::collectRuns(WorkerPool& pool, 
+                                   const vector<TypeRun>& runs) {
+    vector<TypeRun> chunks;
+    for (const TypeRun& run : runs) {
+        for (size_t first = 0; first < run.count; first += CHUNK_SIZE) {
+            size_t count = (run.count - first < CHUNK_SIZE) ? run.count - first
+                                                            : CHUNK_SIZE;
+            chunks.push_back(TypeRun{run.type, run.sensors + first, count});
+        }
+    }
+    pool.parallelFor(chunks.size(), 1, 
+        [&chunks](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                collectChunk(chunks[i]);
+            }
+        });
+}
@@ -0,0 +1,78 @@
+#ifndef COLLECTIONENGINE_H
+#define COLLECTIONENGINE_H
+
+#include <cstddef>
+#include <vector>
+#include <sys/types.h>
+#include "../Sensor.h"
+#include "../../Utils/WorkerPool.h"
+
+class SensorDatabase;
+
+/**
+ * @brief Collection cycles over every sensor of a database, in parallel
+ *
+ * A cycle has two phases:
+ *
+ *  1. Primary sensors, on the calling thread, masters first: the
+ *     TemperatureSensor 40000 and ContactSensor 50000 readings become the
+ *     global temperature and movement state (SensorCoordinator) that
+ *     every camera reads.
+ *  2. Every other sensor. They only read the coordinator state, so each
+ *     type's list is split into chunks sampled by a WorkerPool, with one
+ *     SensorFactory::collectBatch() call per chunk.
+ *
+ * The readings are then recorded in the database in one call
+ * (SensorDatabase::recordReadings). Sensors the UI holds or removes
+ * meanwhile stay valid: the cycle runs inside an EpochReclaimer guard.
+ */
+class CollectionEngine {
+public:
+    static constexpr size_t CHUNK_SIZE = 256; // Sensors per pool task
+
+    // Sensors of one type, stored contiguously (e.g. a database type list)
+    struct TypeRun {
+        Sensor::Type type;
+        Sensor* const* sensors;
+        size_t count;
+    };
+
+    // Wall times of one cycle
+    struct CycleStats {
+        size_t sensors;     // Sensors sampled
+        size_t primaries;   // Of those, sampled in phase 1
+        unsigned threads;   // Threads used in phase 2
+        double primaryMs;   // Phase 1
+        double parallelMs;  // Phase 2
+        double recordMs;    // Recording and persisting the readings
+        double totalMs;     // Whole cycle
+    };
+
+    // 'threads' counts the calling thread; 0 = one per hardware thread
+    explicit CollectionEngine(SensorDatabase& db, unsigned threads = 0);
+
+    // Non-copyable: owns a worker pool
+    CollectionEngine(const CollectionEngine&) = delete;
+    CollectionEngine& operator=(const CollectionEngine&) = delete;
+
+    // Sample every sensor once; not re-entrant (one cycle at a time)
+    const CycleStats& runCycle();
+
+    // Sample 'runs' in CHUNK_SIZE pieces on 'pool', one batch call per
+    // piece. Primaries are skipped: they go first, one by one
+    static void collectRuns(WorkerPool& pool, const std::vector<TypeRun>& runs);
+
+    const CycleStats& getLastCycle() const { return lastCycle; }
+    size_t getCycleCount() const { return cycles; }
+    unsigned getThreadCount() const { return pool.getThreadCount(); }
+    // Free between cycles, e.g. for a SamplingScheduler
+    WorkerPool& getPool() { return pool; }
+
+private:
+    SensorDatabase& db;
+    WorkerPool pool;
+    CycleStats lastCycle;
+    size_t cycles;
+};
+
+#endif // COLLECTIONENGINE_H
@@ -0,0 +1,394 @@
+#include "SamplingScheduler.h"
+#include "SensorCoordinator.h"
+#include "../../Databases/SensorDatabase.h"
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <cmath>
+
+using namespace std;
+
+// Out-of-line definition for the ODR-used constant
+constexpr u_int8_t SamplingScheduler::UNSCHEDULED;
+
+namespace {
+    const size_t ID_SPACE =
+        Sensor::MAX_SENSOR_ID - Sensor::MIN_SENSOR_ID + 1;
+
+    const unsigned DEFAULT_PERIOD_MS[Sensor::TYPE_COUNT] = {
+        10000,  // HYGROMETER
+        5000,   // AIR_QUALITY
+        2000,   // LUX_METER
+        5000,   // TEMPERATURE
+        100,    // CONTACT: movement must be seen right away
+        1000,   // THERMAL_CAMERA
+        1000    // RGB_CAMERA
+    };
+
+    u_int32_t toTicks(unsigned periodMs) {
+        u_int32_t ticks = (periodMs + SamplingScheduler::TICK_MS - 1) /
+                          SamplingScheduler::TICK_MS;
+        return ticks ? ticks : 1;
+    }
+
+    bool isMaster(const Sensor* sensor) {
+        return SensorCoordinator::isTemperatureMaster(sensor->getSensorId()) ||
+               SensorCoordinator::isContactMaster(sensor->getSensorId());
+    }
+}
+
+SamplingScheduler::SamplingScheduler(SensorDatabase& db, WorkerPool& pool)
+    : db(db), pool(pool), ownerWaiting(0), paused(true), stopping(false),
+      wheel(ID_SPACE), typeOf(ID_SPACE, UNSCHEDULED),
+      periodTicks(ID_SPACE, 0), ownPeriodMs(ID_SPACE, 0),
+      lastSampleMs(ID_SPACE, -1.0), membershipVersion(0),
+      origin(Clock::now()),
+      lastCommitMs(0.0), pendingCommit(false),
+      ticksSampled(0), samples(0), missedPeriods(0), jitterSamples(0),
+      latenessSum(0.0), maxLateness(0.0), jitterSum(0.0), maxJitter(0.0),
+      lastTickMs(0.0) {
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        typePeriodMs[type] = DEFAULT_PERIOD_MS[type];
+    }
+}
+
+SamplingScheduler::~SamplingScheduler() {
+    stop();
+}
+
+void SamplingScheduler::start() {
+    if (isRunning()) {
+        return;
+    }
+    {
+        unique_lock<mutex> lock = lockAsOwner();
+        stopping = false;
+        // Carry on from the tick the wheel stopped at
+        origin = Clock::now() -
+                 chrono::milliseconds(wheel.getCurrentTick() * TICK_MS);
+        lastCommitMs = elapsedMs();
+        synchronize();
+    }
+    scheduler = thread(&SamplingScheduler::run, this);
+}
+
+// Readings taken since the last commit are committed on the way out
+void SamplingScheduler::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    {
+        unique_lock<mutex> lock = lockAsOwner();
+        stopping = true;
+    }
+    wake.notify_all();
+    scheduler.join();
+
+    if (pendingCommit) {
+        db.commitLog();
+        pendingCommit = false;
+    }
+}
+
+void SamplingScheduler::pause() {
+    unique_lock<mutex> lock = lockAsOwner(); // Free only between ticks
+    paused = true;
+}
+
+void SamplingScheduler::resume() {
+    {
+        unique_lock<mutex> lock = lockAsOwner();
+        if (paused) {
+            // Carry on from the tick the wheel stopped at, as start() does.
+            // Times kept since 'origin' skip the pause along with it
+            origin = Clock::now() -
+                     chrono::milliseconds(wheel.getCurrentTick() * TICK_MS);
+        }
+        synchronize();
+        paused = false;
+    }
+    wake.notify_all();
+}
+
+bool SamplingScheduler::isPaused() const {
+    unique_lock<mutex> lock = lockAsOwner();
+    return paused;
+}
+
+void SamplingScheduler::setTypePeriod(Sensor::Type type, unsigned periodMs) {
+    if (type >= Sensor::TYPE_COUNT) {
+        throw invalid_argument("Invalid sensor type");
+    }
+    if (periodMs > MAX_PERIOD_MS) {
+        throw invalid_argument("Sampling period out of range");
+    }
+    unique_lock<mutex> lock = lockAsOwner();
+    typePeriodMs[type] = periodMs ? periodMs : DEFAULT_PERIOD_MS[type];
+    synchronize();
+    for (const Sensor* sensor : db.getSensorsOfType(type)) {
+        synchronizeSensor(sensor->getSensorId());
+    }
+}
+
+unsigned SamplingScheduler::getTypePeriod(Sensor::Type type) const {
+    if (type >= Sensor::TYPE_COUNT) {
+        throw invalid_argument("Invalid sensor type");
+    }
+    unique_lock<mutex> lock = lockAsOwner();
+    return typePeriodMs[type];
+}
+
+unsigned SamplingScheduler::getDefaultPeriod(Sensor::Type type) {
+    if (type >= Sensor::TYPE_COUNT) {
+        throw invalid_argument("Invalid sensor type");
+    }
+    return DEFAULT_PERIOD_MS[type];
+}
+
+bool SamplingScheduler::setSensorPeriod(u_int32_t sensorId,
+                                        unsigned periodMs) {
+    if (periodMs > MAX_PERIOD_MS) {
+        throw invalid_argument("Sampling period out of range");
+    }
+    const Sensor* sensor = db.findSensorById(sensorId);
+    if (!sensor) {
+        return false;
+    }
+    unique_lock<mutex> lock = lockAsOwner();
+    u_int32_t key = sensorId - Sensor::MIN_SENSOR_ID;
+    ownPeriodMs[key] = periodMs;
+    scheduleKey(key, sensor->getType());
+    return true;
+}
+
+bool SamplingScheduler::clearSensorPeriod(u_int32_t sensorId) {
+    return setSensorPeriod(sensorId, 0);
+}
+
+unsigned SamplingScheduler::getSensorPeriod(u_int32_t sensorId) const {
+    if (sensorId < Sensor::MIN_SENSOR_ID || sensorId > Sensor::MAX_SENSOR_ID) {
+        return 0;
+    }
+    unique_lock<mutex> lock = lockAsOwner();
+    u_int32_t key = sensorId - Sensor::MIN_SENSOR_ID;
+    if (typeOf[key] == UNSCHEDULED) {
+        return 0;
+    }
+    return periodTicks[key] * TICK_MS;
+}
+
+SamplingScheduler::Stats SamplingScheduler::getStats() const {
+    unique_lock<mutex> lock = lockAsOwner();
+    Stats stats;
+    stats.ticks = ticksSampled;
+    stats.samples = samples;
+    stats.missedPeriods = missedPeriods;
+    stats.meanLatenessMs = samples ? latenessSum / samples : 0.0;
+    stats.maxLatenessMs = maxLateness;
+    stats.meanJitterMs = jitterSamples ? jitterSum / jitterSamples : 0.0;
+    stats.maxJitterMs = maxJitter;
+    stats.lastTickMs = lastTickMs;
+    stats.scheduledSensors = wheel.size();
+    return stats;
+}
+
+void SamplingScheduler::resetStats() {
+    unique_lock<mutex> lock = lockAsOwner();
+    ticksSampled = 0;
+    samples = 0;
+    missedPeriods = 0;
+    jitterSamples = 0;
+    latenessSum = 0.0;
+    maxLateness = 0.0;
+    jitterSum = 0.0;
+    maxJitter = 0.0;
+    lastTickMs = 0.0;
+}
+
+// Owner side: announce the wait, so that a scheduler running late hands
+// the mutex over between ticks instead of taking it right back
+unique_lock<mutex> SamplingScheduler::lockAsOwner() const {
+    ownerWaiting++;
+    unique_lock<mutex> lock(stateMutex);
+    ownerWaiting--;
+    wake.notify_all();
+    return lock;
+}
+
+// Scheduler thread: sleep to the next tick, then catch up to the clock
+void SamplingScheduler::run() {
+    unique_lock<mutex> lock(stateMutex);
+    while (!stopping) {
+        if (ownerWaiting.load() != 0) {
+            wake.wait(lock, [this]() { return ownerWaiting.load() == 0; });
+            continue;
+        }
+        if (paused) {
+            wake.wait(lock);
+            continue;
+        }
+        u_int64_t nowTick = static_cast<u_int64_t>(elapsedMs() / TICK_MS);
+        if (nowTick <= wheel.getCurrentTick()) {
+            wake.wait_until(lock, origin +
+                chrono::milliseconds((wheel.getCurrentTick() + 1) * TICK_MS));
+            continue;
+        }
+        try {
+            runTick(nowTick);
+        } catch (const exception& e) {
+            cerr << "Error: Scheduled sampling failed: " << e.what() << endl;
+        }
+    }
+}
+
+/**
+ * @brief Advance the wheel to 'nowTick' and sample whatever fell due
+ *
+ * Every sensor due is sampled once, however many of its periods went by
+ * (after an overrun, for instance), and re-armed on its own phase: the next
+ * due tick is a whole number of periods after the one just served.
+ */
+void SamplingScheduler::runTick(u_int64_t nowTick) {
+    double startMs = elapsedMs();
+    expired.clear();
+    while (wheel.getCurrentTick() < nowTick) {
+        wheel.tick(expired);
+    }
+    if (expired.empty()) {
+        return;
+    }
+
+    {
+        EpochReclaimer::Guard guard(db.getReclaimer());
+        due.clear();
+        for (u_int32_t key : expired) {
+            Sensor* sensor = db.findSensorById(key + Sensor::MIN_SENSOR_ID);
+            if (!sensor) {
+                typeOf[key] = UNSCHEDULED; // Gone, resume() was skipped
+                continue;
+            }
+
+            u_int64_t dueTick = wheel.getExpiry(key);
+            u_int32_t period = periodTicks[key];
+            double lateness = startMs - static_cast<double>(dueTick) * TICK_MS;
+            latenessSum += lateness;
+            maxLateness = max(maxLateness, lateness);
+            if (lastSampleMs[key] >= 0.0) {
+                double jitter = fabs(startMs - lastSampleMs[key] -
+                                     static_cast<double>(period) * TICK_MS);
+                jitterSum += jitter;
+                maxJitter = max(maxJitter, jitter);
+                jitterSamples++;
+            }
+            lastSampleMs[key] = startMs;
+
+            u_int64_t next = dueTick + period;
+            if (next <= nowTick) {
+                u_int64_t behind = (nowTick - next) / period + 1;
+                missedPeriods += behind;
+                next += behind * period;
+            }
+            wheel.schedule(key, next - nowTick);
+            due.push_back(sensor);
+        }
+
+        // Primaries on this thread, masters first: cameras read what they set
+        auto primariesEnd = partition(due.begin(), due.end(),
+            [](const Sensor* sensor) { return sensor->isPrimarySensor(); });
+        partition(due.begin(), primariesEnd, isMaster);
+        for (auto it = due.begin(); it != primariesEnd; ++it) {
+            (*it)->collectData();
+        }
+
+        // The rest grouped by type, for one batch call per chunk
+        for (vector<Sensor*>& sensorsOfType : dueByType) {
+            sensorsOfType.clear();
+        }
+        for (auto it = primariesEnd; it != due.end(); ++it) {
+            dueByType[(*it)->getType()].push_back(*it);
+        }
+        runs.clear();
+        for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+            if (!dueByType[type].empty()) {
+                runs.push_back(CollectionEngine::TypeRun{
+                    static_cast<Sensor::Type>(type), 
+                    dueByType[type].data(), dueByType[type].size()});
+            }
+        }
+        CollectionEngine::collectRuns(pool, runs);
+
+        if (!due.empty()) {
+            db.recordReadings(due);
+            pendingCommit = true;
+        }
+    }
+
+    ticksSampled++;
+    samples += due.size();
+    lastTickMs = elapsedMs() - startMs;
+
+    if (pendingCommit && elapsedMs() - lastCommitMs >= COMMIT_INTERVAL_MS) {
+        db.commitLog();
+        lastCommitMs = elapsedMs();
+        pendingCommit = false;
+    }
+}
+
+// Match the timers to the sensors in the database: new sensors (and
+// renamed ones, under their new ID) are armed, removed ones cancelled.
+// Only the IDs changed since the last call are looked at, unless the
+// database can no longer tell which
+void SamplingScheduler::synchronize() {
+    changedIds.clear();
+    if (db.getMembershipChanges(membershipVersion, changedIds)) {
+        for (u_int32_t sensorId : changedIds) {
+            synchronizeSensor(sensorId);
+        }
+    } else {
+        for (u_int32_t key = 0; key < ID_SPACE; key++) {
+            if (typeOf[key] != UNSCHEDULED) {
+                synchronizeSensor(key + Sensor::MIN_SENSOR_ID);
+            }
+        }
+        for (const Sensor* sensor : db.getAllSensors()) {
+            synchronizeSensor(sensor->getSensorId());
+        }
+    }
+    membershipVersion = db.getMembershipVersion();
+}
+
+void SamplingScheduler::synchronizeSensor(u_int32_t sensorId) {
+    u_int32_t key = sensorId - Sensor::MIN_SENSOR_ID;
+    const Sensor* sensor = db.findSensorById(sensorId);
+    if (!sensor) {
+        if (typeOf[key] != UNSCHEDULED) {
+            wheel.cancel(key);
+            typeOf[key] = UNSCHEDULED;
+            ownPeriodMs[key] = 0;
+        }
+        return;
+    }
+    Sensor::Type type = sensor->getType();
+    if (typeOf[key] != type || periodTicks[key] != periodTicksFor(key, type)) {
+        scheduleKey(key, type);
+    }
+}
+
+// First due tick spread over one period, so that a type's sensors do not
+// all fall on the same tick
+void SamplingScheduler::scheduleKey(u_int32_t key, Sensor::Type type) {
+    u_int32_t period = periodTicksFor(key, type);
+    typeOf[key] = static_cast<u_int8_t>(type);
+    periodTicks[key] = period;
+    lastSampleMs[key] = -1.0;
+    wheel.schedule(key, 1 + key % period);
+}
+
+u_int32_t SamplingScheduler::periodTicksFor(u_int32_t key,
+                                            Sensor::Type type) const {
+    return toTicks(ownPeriodMs[key] ? ownPeriodMs[key] : typePeriodMs[type]);
+}
+
+double SamplingScheduler::elapsedMs() const {
+    return chrono::duration<double, milli>(Clock::now() - origin).count();
+}
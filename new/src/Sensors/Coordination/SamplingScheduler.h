@@ -0,0 +1,152 @@
+#ifndef SAMPLINGSCHEDULER_H
+#define SAMPLINGSCHEDULER_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <sys/types.h>
+#include "../Sensor.h"
+#include "../../Utils/TimerWheel.h"
+#include "../../Utils/WorkerPool.h"
+#include "CollectionEngine.h"
+
+class SensorDatabase;
+
+/**
+ * @brief Periodic sampling of every sensor, each at its own period
+ *
+ * Each sensor is one timer of a TimerWheel ticking every TICK_MS. Its
+ * period comes from its type (setTypePeriod) unless it has one of its own
+ * (setSensorPeriod). A scheduler thread wakes once per tick, takes the
+ * sensors due and samples them: primaries on that thread, masters first,
+ * then the rest grouped by type, in batches on a WorkerPool (see
+ * CollectionEngine::collectRuns). The readings are recorded with one
+ * SensorDatabase::recordReadings call per tick and committed every
+ * COMMIT_INTERVAL_MS.
+ *
+ * The database is not thread-safe, so the scheduler only runs while its
+ * owner leaves the database alone: the owner calls pause() before using
+ * it and resume() when done (SystemManager does so around every wait for
+ * user input). pause() waits for the tick in progress; resume() picks up
+ * the sensors added, removed or renamed meanwhile, as reported by
+ * SensorDatabase::getMembershipChanges. The schedule stands still while
+ * paused: on resume every timer carries on from where it stopped, so a
+ * pause counts neither as lateness nor as missed periods.
+ */
+class SamplingScheduler {
+public:
+    static constexpr unsigned TICK_MS = 10;
+    static constexpr unsigned MAX_PERIOD_MS = 3600000;  // One hour
+    static constexpr unsigned COMMIT_INTERVAL_MS = 1000;
+
+    // Timeliness of the samples taken since the last resetStats()
+    struct Stats {
+        u_int64_t ticks;          // Ticks that sampled something
+        u_int64_t samples;
+        u_int64_t missedPeriods;  // Skipped by ticks that overran
+        double meanLatenessMs;    // Sample time minus due time
+        double maxLatenessMs;
+        double meanJitterMs;      // |interval between samples - period|
+        double maxJitterMs;
+        double lastTickMs;        // Sampling and recording of the last tick
+        size_t scheduledSensors;
+    };
+
+    // Batches run on 'pool', used only while sampling is allowed: it can
+    // be shared with a CollectionEngine (CollectionEngine::getPool) whose
+    // cycles the owner runs while paused. Starts paused: call resume() to
+    // let it sample
+    SamplingScheduler(SensorDatabase& db, WorkerPool& pool);
+    ~SamplingScheduler(); // Stops the thread
+
+    // Non-copyable: owns threads
+    SamplingScheduler(const SamplingScheduler&) = delete;
+    SamplingScheduler& operator=(const SamplingScheduler&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return scheduler.joinable(); }
+
+    // Owner side: no tick runs between pause() and resume()
+    void pause();
+    void resume();
+    bool isPaused() const;
+
+    // Periods in ms, rounded up to whole ticks (0 = back to the default)
+    void setTypePeriod(Sensor::Type type, unsigned periodMs);
+    unsigned getTypePeriod(Sensor::Type type) const;
+    static unsigned getDefaultPeriod(Sensor::Type type);
+    // Own period of one sensor; false if there is no such sensor. The
+    // setting is dropped with the sensor
+    bool setSensorPeriod(u_int32_t sensorId, unsigned periodMs);
+    bool clearSensorPeriod(u_int32_t sensorId);
+    unsigned getSensorPeriod(u_int32_t sensorId) const; // 0 if unscheduled
+
+    Stats getStats() const;
+    void resetStats();
+    unsigned getThreadCount() const { return pool.getThreadCount(); }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static constexpr u_int8_t UNSCHEDULED = 0xFF;  // 'typeOf' of free keys
+
+    std::unique_lock<std::mutex> lockAsOwner() const;
+    void run();
+    void runTick(u_int64_t nowTick);
+    void synchronize();
+    void synchronizeSensor(u_int32_t sensorId);
+    void scheduleKey(u_int32_t key, Sensor::Type type);
+    u_int32_t periodTicksFor(u_int32_t key, Sensor::Type type) const;
+    double elapsedMs() const;
+
+    SensorDatabase& db;
+    WorkerPool& pool;
+
+    // Held by the scheduler thread for a whole tick; between ticks it
+    // steps aside while 'ownerWaiting' is set (the mutex is not fair)
+    mutable std::mutex stateMutex;
+    mutable std::condition_variable wake;
+    mutable std::atomic<unsigned> ownerWaiting;
+    bool paused;
+    bool stopping;
+
+    // One timer per sensor ID (key = sensorId - MIN_SENSOR_ID)
+    TimerWheel wheel;
+    std::vector<u_int8_t> typeOf;         // Type scheduled, or UNSCHEDULED
+    std::vector<u_int32_t> periodTicks;   // Period scheduled
+    std::vector<u_int32_t> ownPeriodMs;   // setSensorPeriod(), 0 if none
+    std::vector<double> lastSampleMs;     // Since 'origin', < 0 if never
+    unsigned typePeriodMs[Sensor::TYPE_COUNT];
+    u_int64_t membershipVersion;          // Database changes applied
+    std::vector<u_int32_t> changedIds;    // Scratch of synchronize()
+
+    Clock::time_point origin;             // Time of tick 0
+    double lastCommitMs;
+    bool pendingCommit;                   // Readings recorded since then
+
+    // Statistics
+    u_int64_t ticksSampled;
+    u_int64_t samples;
+    u_int64_t missedPeriods;
+    u_int64_t jitterSamples;
+    double latenessSum;
+    double maxLateness;
+    double jitterSum;
+    double maxJitter;
+    double lastTickMs;
+
+    // Scratch buffers of runTick()
+    std::vector<u_int32_t> expired;
+    std::vector<Sensor*> due;
+    std::vector<Sensor*> dueByType[Sensor::TYPE_COUNT];
+    std::vector<CollectionEngine::TypeRun> runs;
+
+    std::thread scheduler;                // Started last, joined first
+};
+
+#endif // SAMPLINGSCHEDULER_H
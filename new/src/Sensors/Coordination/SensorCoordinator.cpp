@@ -6,23 +6,23 @@
 
 namespace SensorCoordinator {
     // Define the global variables
-    int globalTemperature = 0;
-    bool hasMovement = false;
+    std::atomic<int> globalTemperature(0);
+    std::atomic<bool> hasMovement(false);
 
     void setGlobalTemperature(int temp) {
-        globalTemperature = temp;
+        globalTemperature.store(temp, std::memory_order_relaxed);
     }
 
     void setMovementDetected(bool movement) {
-        hasMovement = movement;
+        hasMovement.store(movement, std::memory_order_relaxed);
     }
 
     int getGlobalTemperature() {
-        return globalTemperature;
+        return globalTemperature.load(std::memory_order_relaxed);
     }
 
     bool isMovementDetected() {
-        return hasMovement;
+        return hasMovement.load(std::memory_order_relaxed);
     }
 
     bool isTemperatureMaster(u_int32_t sensorId) {
@@ -40,14 +40,14 @@ namespace SensorCoordinator {
         Sensor* masterTemp = db.findSensorById(TemperatureSensor::PRIMARY_TEMP_ID);
         if (masterTemp) {
             setGlobalTemperature(masterTemp->getSingleData());
-            std::cout << "  - Loaded temperature: " << globalTemperature << "C" << std::endl;
+            std::cout << "  - Loaded temperature: " << getGlobalTemperature() << "C" << std::endl;
         }
         
         // Load movement from master contact sensor
         Sensor* masterContact = db.findSensorById(ContactSensor::PRIMARY_CONTACT_ID);
         if (masterContact) {
             setMovementDetected(masterContact->getSingleData() == 1);
-            std::cout << "  - Loaded movement: " << (hasMovement ? "YES" : "NO") << std::endl;
+            std::cout << "  - Loaded movement: " << (isMovementDetected() ? "YES" : "NO") << std::endl;
         }
         
         std::cout << "SensorCoordinator initialization complete." << std::endl;
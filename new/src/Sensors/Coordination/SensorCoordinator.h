@@ -2,6 +2,7 @@
 #define SENSORCOORDINATOR_H
 
 #include <sys/types.h>
+#include <atomic>
 
 class SensorDatabase;
 
@@ -21,9 +22,10 @@ namespace SensorCoordinator {
     // Initialization method
     void initializeFromDatabase(SensorDatabase& db);
 
-    // Global shared state - from master sensors 
-    extern int globalTemperature;   // From master TemperatureSensor (ID=40000)
-    extern bool hasMovement;        // From master ContactSensor (ID=50000)
+    // Global shared state - from master sensors. Atomic: masters write it
+    // while cameras on other collector threads read it
+    extern std::atomic<int> globalTemperature;  // From master TemperatureSensor (ID=40000)
+    extern std::atomic<bool> hasMovement;       // From master ContactSensor (ID=50000)
 }
 
 #endif // SENSORCOORDINATOR_H
\ No newline at end of file
@@ -0,0 +1,48 @@
+#include "DriverHardware.h"
+#include <stdexcept>
+
+using namespace std;
+
+DriverHardware::DriverHardware(HardwareSource& fallback) : fallback(fallback) {
+}
+
+void DriverHardware::attach(Sensor::Type type, const Driver& driver) {
+    if (type >= Sensor::TYPE_COUNT) {
+        throw invalid_argument("Unknown sensor type");
+    }
+    drivers[type] = driver;
+}
+
+void DriverHardware::detach(Sensor::Type type) {
+    if (type < Sensor::TYPE_COUNT) {
+        drivers[type] = nullptr;
+    }
+}
+
+bool DriverHardware::isAttached(Sensor::Type type) const {
+    return type < Sensor::TYPE_COUNT && static_cast<bool>(drivers[type]);
+}
+
+void DriverHardware::read(Sensor::Type type, const u_int32_t* sensorIds,
+                          size_t count, int* out) {
+    if (!isAttached(type)) {
+        fallback.read(type, sensorIds, count, out);
+        return;
+    }
+
+    size_t values = valuesPerReading(type);
+    for (size_t i = 0; i < count; i++) {
+        if (!drivers[type](sensorIds[i], out + i * values)) {
+            fallback.read(type, sensorIds + i, 1, out + i * values);
+        }
+    }
+}
+
+string DriverHardware::describe() const {
+    size_t attached = 0;
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        attached += static_cast<bool>(drivers[type]);
+    }
+    return "Drivers for " + to_string(attached) +
+           " type(s), the rest from " + fallback.describe();
+}
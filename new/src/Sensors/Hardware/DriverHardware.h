@@ -0,0 +1,36 @@
+#ifndef DRIVERHARDWARE_H
+#define DRIVERHARDWARE_H
+
+#include <functional>
+#include "HardwareSource.h"
+
+/**
+ * @brief Hook for real device drivers, one per sensor type
+ *
+ * A driver reads one sensor at a time into 'out' (1 value, or a frame of
+ * MAX_DATA_SIZE for cameras) and returns false if the device did not
+ * answer. Types without a driver, and failed reads, come from the
+ * fallback source. Drivers are called from every collector thread at
+ * once, for different sensors.
+ */
+class DriverHardware : public HardwareSource {
+public:
+    typedef std::function<bool(u_int32_t sensorId, int* out)> Driver;
+
+    explicit DriverHardware(HardwareSource& fallback);
+
+    // Only while no sensor is being read
+    void attach(Sensor::Type type, const Driver& driver);
+    void detach(Sensor::Type type);
+    bool isAttached(Sensor::Type type) const;
+
+    void read(Sensor::Type type, const u_int32_t* sensorIds, size_t count,
+              int* out) override;
+    std::string describe() const override;
+
+private:
+    HardwareSource& fallback;
+    Driver drivers[Sensor::TYPE_COUNT];  // Empty = none attached
+};
+
+#endif // DRIVERHARDWARE_H
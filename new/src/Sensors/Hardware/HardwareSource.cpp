@@ -0,0 +1,27 @@
+#include "HardwareSource.h"
+#include "SimulatedHardware.h"
+
+using namespace std;
+
+atomic<HardwareSource*> HardwareSource::installed(nullptr);
+
+HardwareSource::~HardwareSource() {
+}
+
+HardwareSource& HardwareSource::current() {
+    HardwareSource* source = installed.load(memory_order_acquire);
+    return source ? *source : simulator();
+}
+
+void HardwareSource::install(HardwareSource* source) {
+    installed.store(source, memory_order_release);
+}
+
+SimulatedHardware& HardwareSource::simulator() {
+    static SimulatedHardware defaultSource;
+    return defaultSource;
+}
+
+size_t HardwareSource::valuesPerReading(Sensor::Type type) {
+    return Sensor::isCameraType(type) ? Sensor::MAX_DATA_SIZE : 1;
+}
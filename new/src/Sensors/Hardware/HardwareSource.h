@@ -0,0 +1,53 @@
+#ifndef HARDWARESOURCE_H
+#define HARDWARESOURCE_H
+
+#include <string>
+#include <atomic>
+#include <cstddef>
+#include <sys/types.h>
+#include "../Sensor.h"
+
+class SimulatedHardware;
+
+/**
+ * @brief Where sensor readings come from
+ *
+ * collectData() and the batch collection (SensorFactory::collectBatch)
+ * ask the installed source for every reading. There are three:
+ *
+ *  - SimulatedHardware: the default. Random readings from a fixed seed,
+ *    the same on every run and on any number of threads.
+ *  - ReplayHardware: readings recorded in a file, played back in order.
+ *  - DriverHardware: real drivers, attached per sensor type.
+ *
+ * Sources are read from every collector thread at once, so read() must
+ * be safe to call concurrently for different sensors (one sensor is only
+ * read by one thread at a time, as its storage is only written by one).
+ */
+class HardwareSource {
+public:
+    virtual ~HardwareSource();
+
+    // One reading per sensor, all of 'type': 'count' values into 'out',
+    // or count * MAX_DATA_SIZE for cameras (one frame per sensor)
+    virtual void read(Sensor::Type type, const u_int32_t* sensorIds,
+                      size_t count, int* out) = 0;
+
+    // Short description for status screens
+    virtual std::string describe() const = 0;
+
+    static HardwareSource& current();
+    // Replace the current source; nullptr goes back to the default
+    // simulator. Only while no sensor is being read: the caller keeps
+    // 'source' alive while it is installed
+    static void install(HardwareSource* source);
+    static SimulatedHardware& simulator();  // The default source
+
+    // Values of one reading of 'type' (1, or MAX_DATA_SIZE for cameras)
+    static size_t valuesPerReading(Sensor::Type type);
+
+private:
+    static std::atomic<HardwareSource*> installed;  // nullptr = simulator()
+};
+
+#endif // HARDWARESOURCE_H
@@ -0,0 +1,107 @@
+#include "ReplayHardware.h"
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <cstring>
+
+using namespace std;
+
+ReplayHardware::ReplayHardware(const char* filename, HardwareSource& fallback)
+    : filename(filename), fallback(fallback), readingCount(0) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        throw runtime_error("Could not open replay file '" +
+                            string(filename) + "'");
+    }
+
+    string line;
+    vector<int> reading;
+    for (size_t lineNumber = 1; getline(file, line); lineNumber++) {
+        size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+
+        istringstream fields(line);
+        long long sensorId = 0;
+        if (!(fields >> sensorId)) {
+            if (!fields.eof()) {
+                throw runtime_error("Replay line " + to_string(lineNumber) +
+                                    ": expected a sensor ID");
+            }
+            continue; // Blank line
+        }
+
+        try {
+            if (sensorId < static_cast<long long>(Sensor::MIN_SENSOR_ID) ||
+                sensorId > static_cast<long long>(Sensor::MAX_SENSOR_ID)) {
+                throw runtime_error("sensor ID must be between " +
+                                    to_string(Sensor::MIN_SENSOR_ID) + " and " +
+                                    to_string(Sensor::MAX_SENSOR_ID));
+            }
+
+            reading.clear();
+            int value = 0;
+            while (fields >> value) {
+                reading.push_back(value);
+            }
+            if (!fields.eof()) {
+                throw runtime_error("expected integer readings");
+            }
+            if (reading.size() != 1 &&
+                reading.size() != Sensor::MAX_DATA_SIZE) {
+                throw runtime_error("expected 1 value, or " +
+                                    to_string(Sensor::MAX_DATA_SIZE) +
+                                    " for a camera frame");
+            }
+
+            u_int32_t id = static_cast<u_int32_t>(sensorId);
+            auto found = recordings.find(id);
+            if (found == recordings.end()) {
+                found = recordings.insert(
+                    make_pair(id, Recording{vector<int>(), reading.size(), 0}))
+                    .first;
+            } else if (found->second.valuesPerReading != reading.size()) {
+                throw runtime_error("sensor " + to_string(id) +
+                                    " was recorded with " +
+                                    to_string(found->second.valuesPerReading) +
+                                    " value(s) per reading");
+            }
+            found->second.values.insert(found->second.values.end(),
+                                        reading.begin(), reading.end());
+            readingCount++;
+        } catch (const runtime_error& e) {
+            throw runtime_error("Replay line " + to_string(lineNumber) +
+                                ": " + e.what());
+        }
+    }
+}
+
+// Only the sensor's own Recording::next changes, so different sensors can
+// be read concurrently
+void ReplayHardware::read(Sensor::Type type, const u_int32_t* sensorIds,
+                          size_t count, int* out) {
+    size_t values = valuesPerReading(type);
+    for (size_t i = 0; i < count; i++) {
+        int* reading = out + i * values;
+        auto found = recordings.find(sensorIds[i]);
+        if (found == recordings.end() ||
+            found->second.valuesPerReading != values) {
+            fallback.read(type, sensorIds + i, 1, reading);
+            continue;
+        }
+
+        Recording& recording = found->second;
+        memcpy(reading, &recording.values[recording.next],
+               values * sizeof(int));
+        recording.next += values;
+        if (recording.next == recording.values.size()) {
+            recording.next = 0;
+        }
+    }
+}
+
+string ReplayHardware::describe() const {
+    return "Replay of " + filename + " (" + to_string(readingCount) +
+           " reading(s) of " + to_string(recordings.size()) + " sensor(s))";
+}
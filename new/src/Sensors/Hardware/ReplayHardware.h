@@ -0,0 +1,53 @@
+#ifndef REPLAYHARDWARE_H
+#define REPLAYHARDWARE_H
+
+#include <vector>
+#include <unordered_map>
+#include "HardwareSource.h"
+
+/**
+ * @brief Readings recorded in a text file, played back in order
+ *
+ * One reading per line:
+ *
+ *     <sensorId> <value> [<value> ...]
+ *
+ * with one value for scalar sensors and MAX_DATA_SIZE (64) for a camera
+ * frame. Each read of a sensor returns its next recorded reading, back to
+ * the first one after the last. Blank lines and anything after '#' are
+ * ignored. Example:
+ *
+ *     # Night shift, wing B
+ *     40000 19
+ *     40000 18
+ *     50000 1
+ *
+ * Sensors without a recording, or recorded with a different number of
+ * values than their type has, are read from the fallback source.
+ */
+class ReplayHardware : public HardwareSource {
+public:
+    // Parse a replay file; throws runtime_error naming the bad line
+    ReplayHardware(const char* filename, HardwareSource& fallback);
+
+    void read(Sensor::Type type, const u_int32_t* sensorIds, size_t count,
+              int* out) override;
+    std::string describe() const override;
+
+    size_t getSensorCount() const { return recordings.size(); }
+    size_t getReadingCount() const { return readingCount; }
+
+private:
+    struct Recording {
+        std::vector<int> values;  // Readings back to back
+        size_t valuesPerReading;
+        size_t next;              // Offset in 'values' of the next reading
+    };
+
+    std::string filename;
+    HardwareSource& fallback;
+    std::unordered_map<u_int32_t, Recording> recordings;  // By sensor ID
+    size_t readingCount;
+};
+
+#endif // REPLAYHARDWARE_H
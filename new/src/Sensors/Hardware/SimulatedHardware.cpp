@@ -0,0 +1,63 @@
+#include "SimulatedHardware.h"
+#include "../Hygrometer.h"
+#include "../AirQualitySensor.h"
+#include "../LuxMeterSensor.h"
+#include "../TemperatureSensor.h"
+#include "../ContactSensor.h"
+#include "../ThermalCamera.h"
+#include "../RGBCamera.h"
+#include "../../Utils/CounterRandom.h"
+#include <stdexcept>
+
+using namespace std;
+
+namespace {
+    typedef void (*Simulator)(const u_int32_t* streams, int* out,
+                              size_t count);
+
+    // Indexed by Sensor::Type
+    const Simulator SIMULATORS[Sensor::TYPE_COUNT] = {
+        &Hygrometer::simulateReadings,
+        &AirQualitySensor::simulateReadings,
+        &LuxMeterSensor::simulateReadings,
+        &TemperatureSensor::simulateReadings,
+        &ContactSensor::simulateReadings,
+        &ThermalCamera::simulateReadings,
+        &RGBCamera::simulateReadings
+    };
+}
+
+SimulatedHardware::SimulatedHardware(u_int32_t seed)
+    : seed(seed),
+      readingsTaken(Sensor::MAX_SENSOR_ID - Sensor::MIN_SENSOR_ID + 1, 0) {
+}
+
+void SimulatedHardware::read(Sensor::Type type, const u_int32_t* sensorIds,
+                             size_t count, int* out) {
+    if (type >= Sensor::TYPE_COUNT) {
+        throw invalid_argument("Unknown sensor type");
+    }
+    Simulator simulate = SIMULATORS[type];
+    size_t values = valuesPerReading(type);
+
+    u_int32_t streams[Sensor::BATCH_SIZE];
+    for (size_t first = 0; first < count; first += Sensor::BATCH_SIZE) {
+        size_t chunk = (count - first < Sensor::BATCH_SIZE)
+                       ? count - first : Sensor::BATCH_SIZE;
+        for (size_t i = 0; i < chunk; i++) {
+            u_int32_t sensorId = sensorIds[first + i];
+            u_int32_t& taken = readingsTaken[sensorId - Sensor::MIN_SENSOR_ID];
+            streams[i] = CounterRandom::stream(seed, sensorId, taken++);
+        }
+        simulate(streams, out + first * values, chunk);
+    }
+}
+
+string SimulatedHardware::describe() const {
+    return "Simulated (seed " + to_string(seed) + ")";
+}
+
+void SimulatedHardware::reseed(u_int32_t seed) {
+    this->seed = seed;
+    readingsTaken.assign(readingsTaken.size(), 0);
+}
@@ -0,0 +1,39 @@
+#ifndef SIMULATEDHARDWARE_H
+#define SIMULATEDHARDWARE_H
+
+#include <vector>
+#include "HardwareSource.h"
+
+/**
+ * @brief Simulated readings, reproducible from a seed
+ *
+ * Reading n of a sensor is drawn from CounterRandom::stream(seed, ID, n)
+ * by its class's simulateReadings(), so a seed fixes every sensor's
+ * sequence of readings whichever thread takes them, and threads share no
+ * generator state. The only state is the count of readings taken per
+ * sensor ID, written by the thread reading that sensor.
+ *
+ * Cameras still follow the coordinator state (global temperature and
+ * movement) at the time of the reading.
+ */
+class SimulatedHardware : public HardwareSource {
+public:
+    static constexpr u_int32_t DEFAULT_SEED = 20250625;
+
+    explicit SimulatedHardware(u_int32_t seed = DEFAULT_SEED);
+
+    void read(Sensor::Type type, const u_int32_t* sensorIds, size_t count,
+              int* out) override;
+    std::string describe() const override;
+
+    // Start every sensor's sequence over from 'seed'; only while no
+    // sensor is being read
+    void reseed(u_int32_t seed);
+    u_int32_t getSeed() const { return seed; }
+
+private:
+    u_int32_t seed;
+    std::vector<u_int32_t> readingsTaken;  // Per ID - MIN_SENSOR_ID
+};
+
+#endif // SIMULATEDHARDWARE_H
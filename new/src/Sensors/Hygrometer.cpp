@@ -1,7 +1,6 @@
 #include "Hygrometer.h"
+#include "../Utils/CounterRandom.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 
 using namespace std;
 
@@ -11,6 +10,11 @@ Hygrometer::Hygrometer(u_int32_t sensorId)
     collectData();
 }
 
+// Same, without the initial reading (bulk provisioning)
+Hygrometer::Hygrometer(u_int32_t sensorId, Unsampled) 
+    : Sensor(sensorId, Type::HYGROMETER) {
+}
+
 Hygrometer* Hygrometer::createPrimary() {
     cout << "[SYSTEM] Loading PRIMARY Hygrometer Sensor (ID=" << PRIMARY_HYGRO_ID << ")" << endl;
     return new Hygrometer(PRIMARY_HYGRO_ID);
@@ -18,7 +22,25 @@ Hygrometer* Hygrometer::createPrimary() {
 
 // Implementation of pure virtual method collectData
 void Hygrometer::collectData() {
-    readHumidityFromHardware();
+    readFromHardware();
+}
+
+// Simulated humidity in percentage (0-100% RH): a comfortable indoor 45%
+// plus seasonal variance (-25 to +35)
+void Hygrometer::simulateReadings(const u_int32_t* streams, int* out, 
+                                  size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int humidity = 45 + CounterRandom::uniform(streams[i], 0, 61) - 25;
+        out[i] = humidity < 0 ? 0 : (humidity > 100 ? 100 : humidity);
+    }
+}
+
+void Hygrometer::collectBatch(Sensor* const* sensors, size_t count) {
+    readBatchFromHardware(sensors, count);
+}
+
+Sensor* Hygrometer::clone() const {
+    return new Hygrometer(*this);
 }
 
 // Human-readable humidity interpretation
@@ -38,40 +60,6 @@ const char* Hygrometer::getHumidityDescription() const {
     }
 }
 
-// Private method to simulate reading from hardware
-int Hygrometer::readHumidityFromHardware() {
-    // Simulate humidity reading in percentage (0-100% RH)
-    // Typical indoor humidity ranges:
-    // - Too dry: 0-30%
-    // - Dry: 30-35%
-    // - Optimal: 35-60%
-    // - Humid: 60-70%
-    // - Too humid: 70-100%
-    
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        seeded = true;
-    }
-    
-    // Generate realistic humidity values with seasonal variation
-    // Base humidity around 45% (comfortable indoor level)
-    int baseHumidity = 45;
-    
-    // Add realistic variance (-25 to +35 for seasonal changes)
-    int variance = (rand() % 61) - 25; // -25 to +35
-    int finalHumidity = baseHumidity + variance;
-    
-    // Ensure humidity is within valid range (0-100%)
-    if (finalHumidity < 0) finalHumidity = 0;
-    if (finalHumidity > 100) finalHumidity = 100;
-    
-    // Set the sensor data
-    setSingleData(finalHumidity);
-    
-    return finalHumidity;
-}
-
 std::ostream& operator<<(std::ostream& os, const Hygrometer& sensor) {
     os << "Humidity: " << sensor.getSingleData() << "%";
     os << " (" << sensor.getHumidityDescription() << ")";
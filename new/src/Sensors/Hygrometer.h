@@ -2,30 +2,36 @@
 #define HYGROMETER_H
 
 #include "Sensor.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class Hygrometer : public Sensor {
+class Hygrometer : public Sensor, public PoolAllocated<Hygrometer> {
 public:
     static constexpr u_int32_t PRIMARY_HYGRO_ID = 10000;
+    static constexpr Type SENSOR_TYPE = HYGROMETER;
 
     // Constructor - follows same pattern as other derived classes
     Hygrometer(u_int32_t sensorId);
+    Hygrometer(u_int32_t sensorId, Unsampled); // Takes no reading
 
     // Constructor 2: Primary sensor (ID=0)
     static Hygrometer* createPrimary();
 
     // Implement pure virtual method from Sensor
     void collectData() override;
+    Sensor* clone() const override;
+
+    // Simulated hardware (SimulatedHardware): one reading per stream into
+    // out[0, count), drawn from CounterRandom streams
+    static void simulateReadings(const u_int32_t* streams, int* out,
+                                 size_t count);
+    static void collectBatch(Sensor* const* sensors, size_t count); // Same type
     
     // Helper methods to interpret humidity data
     const char* getHumidityDescription() const;
 
     friend std::ostream& operator<<(std::ostream& os, const Hygrometer& sensor);
-
-private:
-    // Private method to simulate reading from hardware
-    int readHumidityFromHardware();
 };
 
 #endif // HYGROMETER_H
\ No newline at end of file
@@ -1,7 +1,6 @@
 #include "LuxMeterSensor.h"
+#include "../Utils/CounterRandom.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 
 using namespace std;
 
@@ -11,6 +10,11 @@ LuxMeterSensor::LuxMeterSensor(u_int32_t sensorId)
     collectData();
 }
 
+// Same, without the initial reading (bulk provisioning)
+LuxMeterSensor::LuxMeterSensor(u_int32_t sensorId, Unsampled) 
+    : Sensor(sensorId, Type::LUX_METER) {
+}
+
 LuxMeterSensor* LuxMeterSensor::createPrimary() {
     cout << "[SYSTEM] Loading PRIMARY LuxMeterSensor (ID=" 
          << PRIMARY_LUX_ID << ")" << endl;
@@ -19,7 +23,44 @@ LuxMeterSensor* LuxMeterSensor::createPrimary() {
 
 // Implementation of pure virtual method collectData
 void LuxMeterSensor::collectData() {
-    readLuxFromHardware();
+    readFromHardware();
+}
+
+namespace {
+    // Lighting scenarios: first lux value and width of each range, picked
+    // with the cumulative percentages below
+    //   5% very dark (night, power outage)      0-9 lux
+    //  10% dim (emergency lighting, dawn/dusk)  10-49 lux
+    //  20% low light (evening indoor)           50-199 lux
+    //  35% normal indoor lighting               200-499 lux
+    //  20% bright indoor lighting               500-999 lux
+    //   8% very bright (near windows)           1000-4999 lux
+    //   2% daylight                             5000-19999 lux
+    const int SCENARIO_BASE[] = {0, 10, 50, 200, 500, 1000, 5000};
+    const int SCENARIO_SPAN[] = {10, 40, 150, 300, 500, 4000, 15000};
+}
+
+// Simulated light intensity: a scenario's range plus variance (-10 to
+// +10), without branches
+void LuxMeterSensor::simulateReadings(const u_int32_t* streams, int* out, 
+                                      size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int scenario = CounterRandom::uniform(streams[i], 0, 100);
+        int index = (scenario >= 5) + (scenario >= 15) + (scenario >= 35) +
+                    (scenario >= 70) + (scenario >= 90) + (scenario >= 98);
+        int lux = SCENARIO_BASE[index] + 
+                  CounterRandom::uniform(streams[i], 1, SCENARIO_SPAN[index]) + 
+                  CounterRandom::uniform(streams[i], 2, 21) - 10;
+        out[i] = lux < 0 ? 0 : (lux > 100000 ? 100000 : lux);
+    }
+}
+
+void LuxMeterSensor::collectBatch(Sensor* const* sensors, size_t count) {
+    readBatchFromHardware(sensors, count);
+}
+
+Sensor* LuxMeterSensor::clone() const {
+    return new LuxMeterSensor(*this);
 }
 
 // Human-readable light level interpretation
@@ -45,67 +86,6 @@ const char* LuxMeterSensor::getLightLevelDescription() const {
     }
 }
 
-// Private method to simulate reading from hardware
-int LuxMeterSensor::readLuxFromHardware() {
-    // Simulate lux reading (light intensity)
-    // Common lux values:
-    // - Moonlight: 0.1-1 lux
-    // - Candle: 10-15 lux
-    // - Street light: 15-50 lux
-    // - Living room: 50-200 lux
-    // - Office lighting: 200-500 lux
-    // - Bright office: 500-1000 lux
-    // - Daylight (indoors): 1000-5000 lux
-    // - Direct sunlight: 10000-100000 lux
-    
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        seeded = true;
-    }
-    
-    // Generate realistic lux values based on time simulation
-    // Simulate different lighting conditions with weighted probabilities
-    int scenario = rand() % 100;
-    int luxValue;
-    
-    if (scenario < 5) {
-        // 5% - Very dark (night, power outage)
-        luxValue = rand() % 10; // 0-9 lux
-    } else if (scenario < 15) {
-        // 10% - Dim lighting (emergency lighting, dawn/dusk)
-        luxValue = 10 + (rand() % 40); // 10-49 lux
-    } else if (scenario < 35) {
-        // 20% - Low light (evening indoor)
-        luxValue = 50 + (rand() % 150); // 50-199 lux
-    } else if (scenario < 70) {
-        // 35% - Normal indoor lighting
-        luxValue = 200 + (rand() % 300); // 200-499 lux
-    } else if (scenario < 90) {
-        // 20% - Bright indoor lighting
-        luxValue = 500 + (rand() % 500); // 500-999 lux
-    } else if (scenario < 98) {
-        // 8% - Very bright (near windows, bright office)
-        luxValue = 1000 + (rand() % 4000); // 1000-4999 lux
-    } else {
-        // 2% - Daylight conditions
-        luxValue = 5000 + (rand() % 15000); // 5000-19999 lux
-    }
-    
-    // Add small random variance for realism
-    int variance = (rand() % 21) - 10; // -10 to +10
-    luxValue += variance;
-    
-    // Ensure lux is within valid range
-    if (luxValue < 0) luxValue = 0;
-    if (luxValue > 100000) luxValue = 100000;
-    
-    // Set the sensor data
-    setSingleData(luxValue);
-    
-    return luxValue;
-}
-
 std::ostream& operator<<(std::ostream& os, const LuxMeterSensor& sensor) {
     os << "Light: " << sensor.getSingleData() << " lux";
     os << " (" << sensor.getLightLevelDescription() << ")";
@@ -2,30 +2,36 @@
 #define LUXMETERSENSOR_H
 
 #include "Sensor.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class LuxMeterSensor : public Sensor {
+class LuxMeterSensor : public Sensor, public PoolAllocated<LuxMeterSensor> {
 public:
     static constexpr u_int32_t PRIMARY_LUX_ID = 30000;
+    static constexpr Type SENSOR_TYPE = LUX_METER;
 
     // Constructor - follows same pattern as other derived classes
     LuxMeterSensor(u_int32_t sensorId);
+    LuxMeterSensor(u_int32_t sensorId, Unsampled); // Takes no reading
 
     // Constructor 2: Primary sensor (ID=0)
     static LuxMeterSensor* createPrimary();
 
     // Implement pure virtual method from Sensor
     void collectData() override;
+    Sensor* clone() const override;
+
+    // Simulated hardware (SimulatedHardware): one reading per stream into
+    // out[0, count), drawn from CounterRandom streams
+    static void simulateReadings(const u_int32_t* streams, int* out,
+                                 size_t count);
+    static void collectBatch(Sensor* const* sensors, size_t count); // Same type
     
     // Helper methods to interpret light level data
     const char* getLightLevelDescription() const;
 
     friend std::ostream& operator<<(std::ostream& os, const LuxMeterSensor& sensor);
-
-private:
-    // Private method to simulate reading from hardware
-    int readLuxFromHardware();
 };
 
 #endif // LUXMETERSENSOR_H
\ No newline at end of file
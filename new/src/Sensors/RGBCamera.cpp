@@ -1,8 +1,7 @@
 #include "RGBCamera.h"
 #include "Coordination/SensorCoordinator.h"
+#include "../Utils/CounterRandom.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 #include <iomanip>
 #include <cmath>
 
@@ -14,6 +13,11 @@ RGBCamera::RGBCamera(u_int32_t sensorId)
     collectData();
 }
 
+// Same, without the initial reading (bulk provisioning)
+RGBCamera::RGBCamera(u_int32_t sensorId, Unsampled) 
+    : Sensor(sensorId, Type::RGB_CAMERA) {
+}
+
 RGBCamera* RGBCamera::createPrimary() {
     cout << "[SYSTEM] Loading PRIMARY RGBCamera (ID=" 
          << PRIMARY_RGB_ID << ")" << endl;
@@ -22,7 +26,32 @@ RGBCamera* RGBCamera::createPrimary() {
 
 // Implementation of pure virtual method collectData
 void RGBCamera::collectData() {
-    readRGBDataFromHardware();
+    readFromHardware();
+}
+
+// Simulated frames: bright (180) with lights on after movement, dark (80)
+// otherwise, each pixel within 20 of it and capped to 0-255
+void RGBCamera::simulateReadings(const u_int32_t* streams, int* out, 
+                                 size_t count) {
+    // COORDINATION: Use movement state instead of random scenarios
+    int baseValue = SensorCoordinator::isMovementDetected() ? 180 : 80;
+    for (size_t frame = 0; frame < count; frame++) {
+        int* pixels = out + frame * MAX_DATA_SIZE;
+        for (size_t i = 0; i < MAX_DATA_SIZE; i++) {
+            int pixelValue = baseValue + 
+                             CounterRandom::uniform(streams[frame], i, 41) - 20;
+            pixels[i] = pixelValue < 0 ? 0 
+                                       : (pixelValue > 255 ? 255 : pixelValue);
+        }
+    }
+}
+
+void RGBCamera::collectBatch(Sensor* const* sensors, size_t count) {
+    readBatchFromHardware(sensors, count);
+}
+
+Sensor* RGBCamera::clone() const {
+    return new RGBCamera(*this);
 }
 
 // Human-readable image quality interpretation (simplified)
@@ -37,42 +66,6 @@ const char* RGBCamera::getImageQualityDescription() const {
     }
 }
 
-void RGBCamera::readRGBDataFromHardware() {
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        seeded = true;
-    }
-    
-    int rgbData[MAX_DATA_SIZE];
-    
-    // COORDINATION: Use movement state instead of random scenarios
-    bool hasMovement = SensorCoordinator::isMovementDetected();
-    
-    int baseValue;
-    if (hasMovement) {
-        // Movement detected -> lights ON -> bright image
-        baseValue = 180;
-    } else {
-        // No movement -> lights OFF -> dark image
-        baseValue = 80;
-    }
-    
-    // Generate pixel values around coordinated base value
-    for (size_t i = 0; i < MAX_DATA_SIZE; i++) {
-        int variation = (rand() % 41) - 20; // -20 to +20
-        int pixelValue = baseValue + variation;
-        
-        // Ensure valid range (0-255)
-        if (pixelValue < 0) pixelValue = 0;
-        if (pixelValue > 255) pixelValue = 255;
-        
-        rgbData[i] = pixelValue;
-    }
-    
-    setFullData(rgbData);
-}
-
 std::ostream& operator<<(std::ostream& os, const RGBCamera& sensor) {
     os << "RGBCamera #" << sensor.getSensorId() 
        << " captured image (" << sensor.getImageQualityDescription() << ")" << endl;
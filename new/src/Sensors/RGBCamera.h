@@ -2,30 +2,36 @@
 #define RGBCAMERA_H
 
 #include "Sensor.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class RGBCamera : public Sensor {
+class RGBCamera : public Sensor, public PoolAllocated<RGBCamera> {
 public:
     static constexpr u_int32_t PRIMARY_RGB_ID = 70000;
+    static constexpr Type SENSOR_TYPE = RGB_CAMERA;
 
     // Constructor - follows same pattern as other derived classes
     RGBCamera(u_int32_t sensorId);
+    RGBCamera(u_int32_t sensorId, Unsampled); // Takes no reading
 
     // Constructor 2: Primary sensor (ID=0)
     static RGBCamera* createPrimary();
 
     // Implement pure virtual method from Sensor
     void collectData() override;
+    Sensor* clone() const override;
+
+    // Simulated hardware (SimulatedHardware): one frame per stream into
+    // out[0, count * MAX_DATA_SIZE), drawn from CounterRandom streams
+    static void simulateReadings(const u_int32_t* streams, int* out,
+                                 size_t count);
+    static void collectBatch(Sensor* const* sensors, size_t count); // Same type
     
     // Helper method to interpret RGB data
     const char* getImageQualityDescription() const;
 
     friend std::ostream& operator<<(std::ostream& os, const RGBCamera& sensor);
-
-private:
-    // Private method to simulate reading from hardware
-    void readRGBDataFromHardware();
 };
 
 #endif // RGBCAMERA_H
\ No newline at end of file
@@ -6,26 +6,61 @@
 #include "ContactSensor.h"
 #include "ThermalCamera.h"
 #include "RGBCamera.h"
+#include "Hardware/HardwareSource.h"
+#include "../Utils/SlabPool.h"
 #include <iostream>
+#include <cstring>
 
-u_int32_t Sensor::sensorCount = 0;
+std::atomic<u_int32_t> Sensor::sensorCount(0);
+
+namespace {
+    // Camera frames, MAX_DATA_SIZE values each
+    SlabPool& framePool() {
+        static SlabPool pool(Sensor::MAX_DATA_SIZE * sizeof(int));
+        return pool;
+    }
+}
 
 u_int32_t Sensor::getSensorCount() {
     return sensorCount;
 }
 
 // Protected constructor - only derived classes can use it
-Sensor::Sensor(u_int32_t sensorId, Type type) {
+Sensor::Sensor(u_int32_t sensorId, Type type) 
+    : value(0), sampled(false), data(&value) {
     setSensorId(sensorId); // Use the setter to validate
     this->type = type;
-    // Initialize data array to zero
-    for (size_t i = 0; i < MAX_DATA_SIZE; i++) {
-        this->data[i] = 0;
+    // Only cameras get a (zeroed) frame; scalar sensors use 'value'
+    if (isCamera()) {
+        allocateFrame();
     }
     this->sensorCount++;
 }
 
+// 'data' must point into our own storage, never the copied sensor's
+Sensor::Sensor(const Sensor& other) 
+    : sensorId(other.sensorId), type(other.type), value(0), sampled(false),
+      data(&value) {
+    if (isCamera()) {
+        allocateFrame();
+    }
+    setFullData(other.data);
+    sampled = other.sampled;
+    this->sensorCount++;
+}
+
+Sensor& Sensor::operator=(const Sensor& other) {
+    if (this != &other) {
+        sensorId = other.sensorId;
+        setType(other.type);
+        setFullData(other.data);
+        sampled = other.sampled;
+    }
+    return *this;
+}
+
 Sensor::~Sensor() {
+    releaseFrame();
     this->sensorCount--;
 }
 
@@ -38,14 +73,82 @@ void Sensor::setSensorId(const u_int32_t& newSensorId) {
     this->sensorId = newSensorId;
 }
 
+void Sensor::readFromHardware() {
+    HardwareSource::current().read(type, &sensorId, 1, data);
+    sampled = true;
+}
+
+// Cameras read straight into their frames; scalar readings go through a
+// buffer of BATCH_SIZE
+void Sensor::readBatchFromHardware(Sensor* const* sensors, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    HardwareSource& source = HardwareSource::current();
+    Type type = sensors[0]->type;
+    if (isCameraType(type)) {
+        for (size_t i = 0; i < count; i++) {
+            source.read(type, &sensors[i]->sensorId, 1, sensors[i]->data);
+            sensors[i]->sampled = true;
+        }
+        return;
+    }
+
+    u_int32_t sensorIds[BATCH_SIZE];
+    int readings[BATCH_SIZE];
+    for (size_t first = 0; first < count; first += BATCH_SIZE) {
+        size_t chunk = (count - first < BATCH_SIZE) ? count - first 
+                                                    : BATCH_SIZE;
+        for (size_t i = 0; i < chunk; i++) {
+            sensorIds[i] = sensors[first + i]->sensorId;
+        }
+        source.read(type, sensorIds, chunk, readings);
+        for (size_t i = 0; i < chunk; i++) {
+            sensors[first + i]->value = readings[i];
+            sensors[first + i]->sampled = true;
+        }
+    }
+}
+
 // Implementation of setFullData method
 void Sensor::setFullData(const int* newData) {
-    for (size_t i = 0; i < MAX_DATA_SIZE; i++) {
-        this->data[i] = newData[i];
+    memcpy(data, newData, getDataSize() * sizeof(int));
+    sampled = true;
+}
+
+// Switching between scalar and camera types swaps the storage, keeping
+// the current reading
+void Sensor::setType(Type type) {
+    bool wasCamera = isCamera();
+    this->type = type;
+    if (isCamera() && !wasCamera) {
+        int reading = value;
+        allocateFrame();
+        data[0] = reading;
+    } else if (!isCamera() && wasCamera) {
+        int reading = data[0];
+        releaseFrame();
+        value = reading;
+    }
+}
+
+void Sensor::allocateFrame() {
+    data = static_cast<int*>(framePool().allocate());
+    memset(data, 0, MAX_DATA_SIZE * sizeof(int));
+}
+
+void Sensor::releaseFrame() {
+    if (data != &value) {
+        framePool().deallocate(data);
+        data = &value;
     }
 }
 
 bool Sensor::isPrimarySensor() const {
+    return isPrimarySensorId(sensorId);
+}
+
+bool Sensor::isPrimarySensorId(u_int32_t sensorId) {
     return (sensorId == Hygrometer::PRIMARY_HYGRO_ID ||
             sensorId == AirQualitySensor::PRIMARY_AIR_QUALITY_ID ||
             sensorId == LuxMeterSensor::PRIMARY_LUX_ID ||
@@ -57,6 +160,10 @@ bool Sensor::isPrimarySensor() const {
 
 // Helper method to distinguish sensor types
 bool Sensor::isCamera() const {
+    return isCameraType(type);
+}
+
+bool Sensor::isCameraType(Type type) {
     return (type == RGB_CAMERA || type == THERMAL_CAMERA);
 }
 
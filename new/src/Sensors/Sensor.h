@@ -4,6 +4,7 @@
 #include <string>
 #include <cstring>
 #include <stdexcept>
+#include <atomic>
 
 using namespace std;
 
@@ -13,7 +14,9 @@ class Sensor {
 public:
     static constexpr u_int32_t MIN_SENSOR_ID = 10000;
     static constexpr u_int32_t MAX_SENSOR_ID = 99999;
-    static constexpr size_t MAX_DATA_SIZE = 64; // Array size for camera data
+    static constexpr size_t MAX_DATA_SIZE = 64; // Values in a camera frame
+    static constexpr size_t TYPE_COUNT = 7;     // Number of values in 'Type'
+    static constexpr size_t BATCH_SIZE = 256;   // Readings per batch pass
     
     enum Type : u_int32_t {
         HYGROMETER = 0,
@@ -24,6 +27,11 @@ public:
         THERMAL_CAMERA = 5,
         RGB_CAMERA = 6
     };
+
+    // Tag of the constructors that take no reading: the sensor reads 0 (a
+    // zeroed frame for cameras) and hasReading() is false until
+    // collectData() or setFullData()
+    struct Unsampled {};
     
     // Abstract Class - Pure Virtual Destructor
     virtual ~Sensor() = 0;
@@ -31,22 +39,30 @@ public:
     // Pure virtual method for collecting sensor data
     virtual void collectData() = 0;
 
+    // Copy of the same concrete type; takes no reading and leaves
+    // SensorCoordinator alone
+    virtual Sensor* clone() const = 0;
+
     // Helper to distinguish sensor atributes
     bool isPrimarySensor() const;
+    static bool isPrimarySensorId(u_int32_t sensorId);
     bool isCamera() const;
+    static bool isCameraType(Type type);
 
     // Getters
     u_int32_t getSensorId() const { return sensorId; }
-    const int* getFullData() const { return data; } // Get full array (cameras)
+    const int* getFullData() const { return data; } // getDataSize() values
     int getSingleData() const { return data[0]; }   // Get single value
+    size_t getDataSize() const { return isCamera() ? MAX_DATA_SIZE : 1; }
     Type getType() const { return type; }
+    bool hasReading() const { return sampled; } // Not a placeholder 0
     static u_int32_t getSensorCount();
     
     // Setters
     void setSensorId(const u_int32_t& newSensorId);
-    void setFullData(const int* newData);
-    void setSingleData(int value) { data[0] = value; }
-    void setType(Type type) { this->type = type; }
+    void setFullData(const int* newData);            // Reads getDataSize()
+    void setSingleData(int value) { data[0] = value; sampled = true; }
+    void setType(Type type);
     
     // Overloaded Operators
     friend std::ostream& operator<<(std::ostream& os, const Sensor& sensor);
@@ -56,13 +72,25 @@ public:
 protected:
     // Constructor: Regular sensor with specific ID
     Sensor(u_int32_t sensorId, Type type);
+    Sensor(const Sensor& other);
+    Sensor& operator=(const Sensor& other);
+
+    // Take a reading from the installed HardwareSource into 'data'
+    void readFromHardware();
+    // Same for 'count' sensors of one type, BATCH_SIZE per source call
+    static void readBatchFromHardware(Sensor* const* sensors, size_t count);
 
     u_int32_t sensorId;
-    int data[MAX_DATA_SIZE];
     Type type;
+    int value;    // Storage of scalar sensors
+    bool sampled; // Read, or given data, at least once
+    int* data;    // Points at 'value', or at a pooled frame for cameras
 
 private:
-    static u_int32_t sensorCount;
+    void allocateFrame();
+    void releaseFrame();
+
+    static std::atomic<u_int32_t> sensorCount; // Sensors are built on any thread
 };
 
 #endif // SENSOR_H
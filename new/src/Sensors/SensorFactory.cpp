@@ -5,6 +5,10 @@
 
 using namespace std;
 
+// Out-of-line definitions for the ODR-used constants
+constexpr u_int32_t SensorFactory::TOMBSTONE_ID;
+constexpr u_int32_t SensorFactory::TOMBSTONE_TYPE;
+
 // Convert Sensor to binary record
 SensorRecord SensorFactory::sensorToRecord(const Sensor* sensor) {
     if (!sensor) {
@@ -15,11 +19,10 @@ SensorRecord SensorFactory::sensorToRecord(const Sensor* sensor) {
     record.sensorId = sensor->getSensorId();
     record.sensorType = static_cast<u_int32_t>(sensor->getType());
     
-    // Copy all data (cameras use full array, others just [0])
-    const int* sensorData = sensor->getFullData();
-    for (size_t i = 0; i < Sensor::MAX_DATA_SIZE; i++) {
-        record.data[i] = sensorData[i];
-    }
+    // Cameras fill the whole array, other sensors just [0]
+    memset(record.data, 0, sizeof(record.data));
+    memcpy(record.data, sensor->getFullData(), 
+           sensor->getDataSize() * sizeof(int));
     
     return record;
 }
@@ -39,99 +42,105 @@ void SensorFactory::writeSensorToFile(std::ofstream& file, const Sensor* sensor)
     file.write(reinterpret_cast<char*>(&record), sizeof(SensorRecord));
 }
 
-// Helper function to check if sensor ID corresponds to a primary sensor
-bool isPrimarySensorId(u_int32_t sensorId, Sensor::Type type) {
-    switch (type) {
-        case Sensor::HYGROMETER:
-            return sensorId == Hygrometer::PRIMARY_HYGRO_ID;
-        case Sensor::AIR_QUALITY:
-            return sensorId == AirQualitySensor::PRIMARY_AIR_QUALITY_ID;
-        case Sensor::LUX_METER:
-            return sensorId == LuxMeterSensor::PRIMARY_LUX_ID;
-        case Sensor::THERMAL_CAMERA:
-            return sensorId == ThermalCamera::PRIMARY_THERMAL_ID;
-        case Sensor::RGB_CAMERA:
-            return sensorId == RGBCamera::PRIMARY_RGB_ID;
-        case Sensor::TEMPERATURE:
-            return sensorId == TemperatureSensor::PRIMARY_TEMP_ID;
-        case Sensor::CONTACT:
-            return sensorId == ContactSensor::PRIMARY_CONTACT_ID;
-        default:
-            return false;
+// Convert binary record to Sensor. The sensor is built without taking a
+// reading, so loading leaves the hardware and SensorCoordinator alone
+// (initializeFromDatabase() takes the masters' state afterwards); primary
+// sensors are the same classes, just at their reserved IDs
+Sensor* SensorFactory::recordToSensor(const SensorRecord& record) {
+    if (record.sensorType >= Sensor::TYPE_COUNT) {
+        return nullptr;
+    }
+    
+    try {
+        Sensor* sensor = createUnsampled(
+            static_cast<Sensor::Type>(record.sensorType), record.sensorId);
+        
+        // Restore state and data from record
+        sensor->setFullData(record.data);
+        return sensor;
+    } catch (const std::exception& e) {
+        std::cerr << "Error creating sensor from record: " << e.what() << endl;
+        return nullptr;
     }
 }
 
-// Helper function to create primary sensors
-Sensor* createPrimarySensor(Sensor::Type type) {
+// Regular sensor of any type with no reading taken yet
+Sensor* SensorFactory::createUnsampled(Sensor::Type type, u_int32_t sensorId) {
     switch (type) {
         case Sensor::HYGROMETER:
-            return Hygrometer::createPrimary();
+            return new Hygrometer(sensorId, Sensor::Unsampled());
         case Sensor::AIR_QUALITY:
-            return AirQualitySensor::createPrimary();
+            return new AirQualitySensor(sensorId, Sensor::Unsampled());
         case Sensor::LUX_METER:
-            return LuxMeterSensor::createPrimary();
+            return new LuxMeterSensor(sensorId, Sensor::Unsampled());
         case Sensor::THERMAL_CAMERA:
-            return ThermalCamera::createPrimary();
+            return new ThermalCamera(sensorId, Sensor::Unsampled());
         case Sensor::RGB_CAMERA:
-            return RGBCamera::createPrimary();
+            return new RGBCamera(sensorId, Sensor::Unsampled());
         case Sensor::TEMPERATURE:
-            return TemperatureSensor::createPrimary();
+            return new TemperatureSensor(sensorId, Sensor::Unsampled());
         case Sensor::CONTACT:
-            return ContactSensor::createPrimary();
+            return new ContactSensor(sensorId, Sensor::Unsampled());
         default:
-            return nullptr;
+            throw std::invalid_argument("Unknown sensor type " + 
+                                        to_string(type));
     }
 }
 
-// Helper function to create regular sensors
-Sensor* createRegularSensor(Sensor::Type type, u_int32_t sensorId) {
+void SensorFactory::collectBatch(Sensor::Type type, Sensor* const* sensors, 
+                                 size_t count) {
     switch (type) {
         case Sensor::HYGROMETER:
-            return new Hygrometer(sensorId);
+            Hygrometer::collectBatch(sensors, count);
+            break;
         case Sensor::AIR_QUALITY:
-            return new AirQualitySensor(sensorId);
+            AirQualitySensor::collectBatch(sensors, count);
+            break;
         case Sensor::LUX_METER:
-            return new LuxMeterSensor(sensorId);
+            LuxMeterSensor::collectBatch(sensors, count);
+            break;
         case Sensor::THERMAL_CAMERA:
-            return new ThermalCamera(sensorId);
+            ThermalCamera::collectBatch(sensors, count);
+            break;
         case Sensor::RGB_CAMERA:
-            return new RGBCamera(sensorId);
+            RGBCamera::collectBatch(sensors, count);
+            break;
         case Sensor::TEMPERATURE:
-            return new TemperatureSensor(sensorId);
+            TemperatureSensor::collectBatch(sensors, count);
+            break;
         case Sensor::CONTACT:
-            return new ContactSensor(sensorId);
+            ContactSensor::collectBatch(sensors, count);
+            break;
         default:
-            return nullptr;
+            throw std::invalid_argument("Unknown sensor type " + 
+                                        to_string(type));
     }
 }
 
-// Convert binary record to Sensor
-Sensor* SensorFactory::recordToSensor(const SensorRecord& record) {
-    try {
-        Sensor* sensor = nullptr;
-        
-        // Create sensor based on type and whether it's primary
-        bool isPrimary = isPrimarySensorId(record.sensorId, 
-                static_cast<Sensor::Type>(record.sensorType));
-        
-        if (isPrimary) {
-            sensor = createPrimarySensor(
-                static_cast<Sensor::Type>(record.sensorType));
-        } else {
-            sensor = createRegularSensor(
-                static_cast<Sensor::Type>(record.sensorType), record.sensorId);
-        }
-        
-        if (sensor) {
-            // Restore state and data from record
-            sensor->setFullData(record.data);
-        }
-        
-        return sensor;
-    } catch (const std::exception& e) {
-        std::cerr << "Error creating sensor from record: " << e.what() << endl;
-        return nullptr;
+// Check the fields of a raw record before converting it
+bool SensorFactory::isValidRecord(const SensorRecord& record) {
+    if (record.sensorId < Sensor::MIN_SENSOR_ID || 
+        record.sensorId > Sensor::MAX_SENSOR_ID) {
+        return false; // Invalid record: sensor ID out of range
+    }
+    if (record.sensorType >= Sensor::TYPE_COUNT) { // 7 types: 0-6
+        return false; // Invalid record: unrecognized sensor type
     }
+    return true;
+}
+
+// Record left in the slot of a removed sensor
+SensorRecord SensorFactory::tombstoneRecord() {
+    SensorRecord record;
+    memset(&record, 0, sizeof(record));
+    record.sensorId = TOMBSTONE_ID;
+    record.sensorType = TOMBSTONE_TYPE;
+    return record;
+}
+
+bool SensorFactory::isTombstone(const SensorRecord& record) {
+    return record.sensorId == TOMBSTONE_ID && 
+           record.sensorType == TOMBSTONE_TYPE;
 }
 
 /**
@@ -157,12 +166,8 @@ Sensor* SensorFactory::readSensorFromFile(std::ifstream& file) {
     // Read binary record from file
     if (file.read(reinterpret_cast<char*>(&record), sizeof(SensorRecord))) {
         // Multiple validations to ensure record integrity
-        if (record.sensorId < Sensor::MIN_SENSOR_ID || 
-            record.sensorId > Sensor::MAX_SENSOR_ID) {
-            return nullptr; // Invalid record: sensor ID out of range
-        }
-        if (record.sensorType > 6) { // 7 types: 0-6
-            return nullptr; // Invalid record: unrecognized sensor type
+        if (!isValidRecord(record)) {
+            return nullptr;
         }
         
         // All validations passed, convert record to Sensor object
@@ -171,4 +176,29 @@ Sensor* SensorFactory::readSensorFromFile(std::ifstream& file) {
     
     // End of file or read error occurred
     return nullptr;
-}
\ No newline at end of file
+}
+
+SlabPool::Stats SensorFactory::poolStats() {
+    SlabPool* pools[] = {
+        &Hygrometer::pool(), &AirQualitySensor::pool(), 
+        &LuxMeterSensor::pool(), &TemperatureSensor::pool(),
+        &ContactSensor::pool(), &ThermalCamera::pool(), &RGBCamera::pool()
+    };
+    
+    SlabPool::Stats total = {0, 0, 0};
+    for (SlabPool* pool : pools) {
+        SlabPool::Stats stats = pool->getStats();
+        total.liveObjects += stats.liveObjects;
+        total.slabCount += stats.slabCount;
+        total.reservedBytes += stats.reservedBytes;
+    }
+    return total;
+}
+
+// Free the slabs emptied by removals (e.g. after clearing the database)
+size_t SensorFactory::releaseUnusedMemory() {
+    return Hygrometer::pool().trim() + AirQualitySensor::pool().trim() +
+           LuxMeterSensor::pool().trim() + TemperatureSensor::pool().trim() +
+           ContactSensor::pool().trim() + ThermalCamera::pool().trim() +
+           RGBCamera::pool().trim();
+}
@@ -21,13 +21,33 @@ struct SensorRecord {
 
 class SensorFactory {
 public:
+    static constexpr u_int32_t TOMBSTONE_ID = 0;           // Below MIN_SENSOR_ID
+    static constexpr u_int32_t TOMBSTONE_TYPE = 0xFFFFFFFF;
+
     // Binary record conversion methods
     static SensorRecord sensorToRecord(const Sensor* sensor);
-    static Sensor* recordToSensor(const SensorRecord& record);
+    static Sensor* recordToSensor(const SensorRecord& record); // No reading
+    static bool isValidRecord(const SensorRecord& record);
+
+    // Bulk provisioning: a regular sensor that takes no initial reading
+    static Sensor* createUnsampled(Sensor::Type type, u_int32_t sensorId);
+
+    // Sample 'count' sensors, all of 'type', with one batch call of that
+    // type instead of one collectData() per sensor
+    static void collectBatch(Sensor::Type type, Sensor* const* sensors, 
+                             size_t count);
+    
+    // Tombstones mark freed slots of an in-place updated sensors.dat
+    static SensorRecord tombstoneRecord();
+    static bool isTombstone(const SensorRecord& record);
     
     // Methods for direct binary file access
     static void writeSensorToFile(std::ofstream& file, const Sensor* sensor);
     static Sensor* readSensorFromFile(std::ifstream& file);
+    
+    // Slab pools behind the concrete sensor classes (summed over types)
+    static SlabPool::Stats poolStats();
+    static size_t releaseUnusedMemory(); // Bytes returned to the system
 };
 
 #endif // SENSOR_FACTORY_H
\ No newline at end of file
@@ -1,8 +1,7 @@
 #include "TemperatureSensor.h"
 #include "Coordination/SensorCoordinator.h"
+#include "../Utils/CounterRandom.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 
 using namespace std;
 
@@ -12,6 +11,11 @@ TemperatureSensor::TemperatureSensor(u_int32_t sensorId)
     collectData();
 }
 
+// Same, without the initial reading (bulk provisioning)
+TemperatureSensor::TemperatureSensor(u_int32_t sensorId, Unsampled) 
+    : Sensor(sensorId, Type::TEMPERATURE) {
+}
+
 TemperatureSensor* TemperatureSensor::createPrimary() {
     cout << "[SYSTEM] Loading PRIMARY TemperatureSensor (ID=" 
          << PRIMARY_TEMP_ID << ")" << endl;
@@ -20,7 +24,43 @@ TemperatureSensor* TemperatureSensor::createPrimary() {
 
 // Implementation of pure virtual method collectData
 void TemperatureSensor::collectData() {
-    readTemperatureFromHardware();
+    readFromHardware();
+    
+    // COORDINATION: Only master updates global state
+    if (SensorCoordinator::isTemperatureMaster(getSensorId())) {
+        SensorCoordinator::setGlobalTemperature(getSingleData());
+    }
+}
+
+// Simulated indoor temperature in Celsius: comfortable 18-25°C, with a 10%
+// chance of cold (5-17°C) and 10% of hot (26-40°C), plus variance (-2 to
+// +2), without branches
+void TemperatureSensor::simulateReadings(const u_int32_t* streams, int* out, 
+                                         size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        int normal = 18 + CounterRandom::uniform(streams[i], 0, 8);
+        int extreme = CounterRandom::uniform(streams[i], 1, 100);
+        int cold = 5 + CounterRandom::uniform(streams[i], 2, 13);
+        int hot = 26 + CounterRandom::uniform(streams[i], 3, 15);
+        int base = extreme < 10 ? cold : (extreme < 20 ? hot : normal);
+        out[i] = base + CounterRandom::uniform(streams[i], 4, 5) - 2;
+    }
+}
+
+void TemperatureSensor::collectBatch(Sensor* const* sensors, size_t count) {
+    readBatchFromHardware(sensors, count);
+    
+    // COORDINATION: Only master updates global state
+    for (size_t i = 0; i < count; i++) {
+        if (SensorCoordinator::isTemperatureMaster(sensors[i]->getSensorId())) {
+            SensorCoordinator::setGlobalTemperature(
+                sensors[i]->getSingleData());
+        }
+    }
+}
+
+Sensor* TemperatureSensor::clone() const {
+    return new TemperatureSensor(*this);
 }
 
 // Human-readable temperature interpretation
@@ -46,45 +86,6 @@ const char* TemperatureSensor::getTemperatureDescription() const {
     }
 }
 
-// Private method to simulate reading from hardware
-int TemperatureSensor::readTemperatureFromHardware() {
-    // Simulate temperature reading in Celsius
-    // Typical indoor temperature ranges: 16-30°C
-    
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        seeded = true;
-    }
-    
-    // Base comfortable temperature (18-25°C range)
-    int baseTemperature = 18 + (rand() % 8); // 18-25°C
-    
-    // Add occasional extreme variations
-    int extremeChance = rand() % 100;
-    if (extremeChance < 10) {
-        // 10% chance of cold (5-17°C)
-        baseTemperature = 5 + (rand() % 13);
-    } else if (extremeChance < 20) {
-        // 10% chance of hot (26-40°C)
-        baseTemperature = 26 + (rand() % 15);
-    }
-
-    // Add small random variation (-2 to +2)
-    int variance = (rand() % 5) - 2;
-    int temperatureReading = baseTemperature + variance;
-    
-    // Set the sensor data
-    setSingleData(temperatureReading);
-    
-    // COORDINATION: Only master updates global state
-    if (SensorCoordinator::isTemperatureMaster(getSensorId())) {
-        SensorCoordinator::setGlobalTemperature(temperatureReading);
-    }
-
-    return temperatureReading;
-}
-
 std::ostream &operator<<(std::ostream &os, const TemperatureSensor &sensor) {
     os << "Temperature: " << sensor.getSingleData() << "°C";
     os << " (" << sensor.getTemperatureDescription() << ")";
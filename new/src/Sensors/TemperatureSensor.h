@@ -2,30 +2,36 @@
 #define TEMPERATURESENSOR_H
 
 #include "Sensor.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class TemperatureSensor : public Sensor {
+class TemperatureSensor : public Sensor, public PoolAllocated<TemperatureSensor> {
 public:
     static constexpr u_int32_t PRIMARY_TEMP_ID = 40000;
+    static constexpr Type SENSOR_TYPE = TEMPERATURE;
 
     // Constructor - follows same pattern as other derived classes
     TemperatureSensor(u_int32_t sensorId);
+    TemperatureSensor(u_int32_t sensorId, Unsampled); // Takes no reading
 
     // Constructor 2: Primary sensor (ID=0)
     static TemperatureSensor* createPrimary();
 
     // Implement pure virtual method from Sensor
     void collectData() override;
+    Sensor* clone() const override;
+
+    // Simulated hardware (SimulatedHardware): one reading per stream into
+    // out[0, count), drawn from CounterRandom streams
+    static void simulateReadings(const u_int32_t* streams, int* out,
+                                 size_t count);
+    static void collectBatch(Sensor* const* sensors, size_t count); // Same type
     
     // Helper methods to interpret temperature data
     const char* getTemperatureDescription() const;
 
     friend std::ostream& operator<<(std::ostream& os, const TemperatureSensor& sensor);
-
-    private:
-    // Private method to simulate reading from hardware
-    int readTemperatureFromHardware();
 };
 
 #endif // TEMPERATURESENSOR_H
\ No newline at end of file
@@ -1,8 +1,7 @@
 #include "ThermalCamera.h"
 #include "Coordination/SensorCoordinator.h"
+#include "../Utils/CounterRandom.h"
 #include <iostream>
-#include <cstdlib>
-#include <ctime>
 #include <iomanip>
 #include <cmath>
 
@@ -14,6 +13,11 @@ ThermalCamera::ThermalCamera(u_int32_t sensorId)
     collectData();
 }
 
+// Same, without the initial reading (bulk provisioning)
+ThermalCamera::ThermalCamera(u_int32_t sensorId, Unsampled) 
+    : Sensor(sensorId, Type::THERMAL_CAMERA) {
+}
+
 ThermalCamera* ThermalCamera::createPrimary() {
     cout << "[SYSTEM] Loading PRIMARY ThermalCamera (ID=" 
          << PRIMARY_THERMAL_ID << ")" << endl;
@@ -22,7 +26,32 @@ ThermalCamera* ThermalCamera::createPrimary() {
 
 // Implementation of pure virtual method collectData
 void ThermalCamera::collectData() {
-    readThermalDataFromHardware();
+    readFromHardware();
+}
+
+// Simulated frames: every point within 5°C of the coordinated temperature,
+// capped to -10..60°C
+void ThermalCamera::simulateReadings(const u_int32_t* streams, int* out, 
+                                     size_t count) {
+    // COORDINATION: Use global temperature instead of random scenarios
+    int baseTemp = SensorCoordinator::getGlobalTemperature();
+    for (size_t frame = 0; frame < count; frame++) {
+        int* points = out + frame * MAX_DATA_SIZE;
+        for (size_t i = 0; i < MAX_DATA_SIZE; i++) {
+            int tempPoint = baseTemp + 
+                            CounterRandom::uniform(streams[frame], i, 11) - 5;
+            points[i] = tempPoint < -10 ? -10 
+                                        : (tempPoint > 60 ? 60 : tempPoint);
+        }
+    }
+}
+
+void ThermalCamera::collectBatch(Sensor* const* sensors, size_t count) {
+    readBatchFromHardware(sensors, count);
+}
+
+Sensor* ThermalCamera::clone() const {
+    return new ThermalCamera(*this);
 }
 
 const char* ThermalCamera::getThermalDescription() const {
@@ -48,37 +77,6 @@ const char* ThermalCamera::getThermalDescription() const {
     }
 }
 
-void ThermalCamera::readThermalDataFromHardware() {
-    for (size_t i = 0; i < MAX_DATA_SIZE; i++) {
-        data[i] = 0;
-    }
-    
-    static bool seeded = false;
-    if (!seeded) {
-        srand(static_cast<unsigned int>(time(nullptr)));
-        seeded = true;
-    }
-    
-    int thermalData[MAX_DATA_SIZE];
-    
-    // COORDINATION: Use global temperature instead of random scenarios
-    int baseTemp = SensorCoordinator::getGlobalTemperature();
-    
-    // Generate temperature points around the coordinated base temperature
-    for (size_t i = 0; i < MAX_DATA_SIZE; i++) {
-        int variation = (rand() % 11) - 5; // -5 to +5°C around base
-        int tempPoint = baseTemp + variation;
-        
-        // Ensure realistic range
-        if (tempPoint < -10) tempPoint = -10;
-        if (tempPoint > 60) tempPoint = 60;
-        
-        thermalData[i] = tempPoint;
-    }
-    
-    setFullData(thermalData);
-}
-
 std::ostream& operator<<(std::ostream& os, const ThermalCamera& sensor) {
     os << "ThermalCamera #" << sensor.getSensorId() 
        << " captured thermal image (" << sensor.getThermalDescription() << ")" << endl;
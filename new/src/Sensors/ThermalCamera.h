@@ -2,30 +2,36 @@
 #define THERMALCAMERA_H
 
 #include "Sensor.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class ThermalCamera : public Sensor {
+class ThermalCamera : public Sensor, public PoolAllocated<ThermalCamera> {
 public:
     static constexpr u_int32_t PRIMARY_THERMAL_ID = 60000;
+    static constexpr Type SENSOR_TYPE = THERMAL_CAMERA;
 
     // Constructor - follows same pattern as other derived classes
     ThermalCamera(u_int32_t sensorId);
+    ThermalCamera(u_int32_t sensorId, Unsampled); // Takes no reading
 
     // Constructor 2: Primary sensor (ID=0)
     static ThermalCamera* createPrimary();
     
     // Implement pure virtual method from Sensor
     void collectData() override;
+    Sensor* clone() const override;
+
+    // Simulated hardware (SimulatedHardware): one frame per stream into
+    // out[0, count * MAX_DATA_SIZE), drawn from CounterRandom streams
+    static void simulateReadings(const u_int32_t* streams, int* out,
+                                 size_t count);
+    static void collectBatch(Sensor* const* sensors, size_t count); // Same type
     
     // Helper methods to interpret thermal data
     const char* getThermalDescription() const;
 
     friend std::ostream& operator<<(std::ostream& os, const ThermalCamera& sensor);
-
-private:
-    // Private method to simulate reading from hardware
-    void readThermalDataFromHardware();
 };
 
 #endif // 
\ No newline at end of file
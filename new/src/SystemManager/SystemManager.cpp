@@ -11,21 +11,31 @@
 #include "../Sensors/ThermalCamera.h"
 #include "../Sensors/ContactSensor.h"
 #include "../Sensors/SensorFactory.h"
+#include "../Sensors/Hardware/SimulatedHardware.h"
+#include "../Databases/SensorFileView.h"
+#include "../Databases/SensorManifest.h"
 #include "../Databases/Exceptions/UserDatabaseException.h"
 #include <iostream>
 #include <iomanip>
 #include <limits>
 #include <fstream>
-#include <unistd.h>
+#include <chrono>
 
 using namespace std;
 
 SystemManager::SystemManager(const char* userDbFile, const char* sensorDbFile) 
-    : userDB(userDbFile), sensorDB(sensorDbFile), alarmSystem(nullptr), 
-      currentUser(nullptr), systemRunning(false) {
+    : userDB(userDbFile), sensorDB(sensorDbFile), collector(sensorDB), 
+      sampler(sensorDB, collector.getPool()), replay(nullptr), 
+      alarmSystem(nullptr), currentUser(nullptr), systemRunning(false) {
+    // Checkpoints of the sensor database run on a persistence thread
+    sensorDB.setSnapshotCadence(Snapshotter::DEFAULT_CADENCE_SECONDS);
 }
 
 SystemManager::~SystemManager() {
+    InputUtils::setWaitHooks(nullptr, nullptr);
+    sampler.stop();
+    HardwareSource::install(nullptr);
+    delete replay;
     delete alarmSystem;
     logout(); // Clean up current user session
 }
@@ -43,6 +53,13 @@ bool SystemManager::initialize() {
         alarmSystem = new AlarmSystem(sensorDB);
         cout << "✓ Security alarm system initialized" << endl;
         
+        // Sensors are sampled on their own periods while the menus wait
+        // for input, and left alone while an option runs
+        sampler.start();
+        InputUtils::setWaitHooks([this]() { sampler.resume(); },
+                                 [this]() { sampler.pause(); });
+        cout << "✓ Periodic sampling scheduler started" << endl;
+        
         systemRunning = true;
         cout << "✓ System initialization completed successfully" << endl;
         return true;
@@ -212,13 +229,16 @@ void SystemManager::showUserManagement() {
         case 0: return;
     }
     
+    // Group commit of whatever the action logged
+    userDB.commitLog();
+    
     InputUtils::pauseExecution();
 }
 
 void SystemManager::displayUserList() {
     cout << "\n=== USER LIST ===" << endl;
     
-    set<User*> users = userDB.getAllUsers();
+    const set<User*>& users = userDB.getAllUsers();
     if (users.empty()) {
         cout << "No users found in the database." << endl;
         return;
@@ -433,6 +453,7 @@ void SystemManager::changeUserPassword() {
         }
         
         if (userDB.changeUserPass(currentUser, targetUser)) {
+            userDB.commitLog();
             cout << "✓ Password changed successfully." << endl;
         } else {
             cout << "✗ Password change failed." << endl;
@@ -556,9 +577,11 @@ void SystemManager::showSensorManagement() {
     cout << "6. Collect sensor data" << endl;
     cout << "7. Clear sensor database" << endl;
     cout << "8. Test sensor coordination" << endl;
+    cout << "9. Display sensors in ID range" << endl;
+    cout << "10. Provision sensors from manifest" << endl;
     cout << "0. Back to main menu" << endl;
     
-    int choice = InputUtils::getNumberInRange("Select option: ", 0, 8);
+    int choice = InputUtils::getNumberInRange("Select option: ", 0, 10);
     
     switch (choice) {
         case 1: displaySensorList(); break;
@@ -569,32 +592,65 @@ void SystemManager::showSensorManagement() {
         case 6: collectSensorData(); break;
         case 7: clearSensorDatabase(); break;
         case 8: testSensorCoordination(); break;
+        case 9: displaySensorsInIdRange(); break;
+        case 10: provisionFromManifest(); break;
         case 0: return;
     }
     
+    // Group commit of whatever the action logged
+    sensorDB.commitLog();
+    
     InputUtils::pauseExecution();
 }
 
 void SystemManager::displaySensorList() {
     cout << "\n=== SENSOR LIST ===" << endl;
     
-    auto sensors = sensorDB.getAllSensors();
+    // Read-only: list the latest published version, which writers never
+    // block. Sorted by ID, so each type family (10000s, 20000s, ...) is
+    // together
+    SensorTableVersion::Pin table = sensorDB.pinVersion();
+    size_t count = table->getSensorCount();
     
-    if (sensors.empty()) {
+    if (count == 0) {
         cout << "No sensors in database." << endl;
         return;
     }
     
-    cout << "Total sensors: " << sensors.size() << endl;
+    cout << "Total sensors: " << count << endl;
     cout << "--------------------------------------" << endl;
     
-    for (size_t i = 0; i < sensors.size(); ++i) {
-        cout << "\n[" << (i + 1) << "/" << sensors.size() << "] ";
-        displaySensorDetails(sensors[i]);
+    for (size_t i = 0; i < count; ++i) {
+        cout << "\n[" << (i + 1) << "/" << count << "] ";
+        displaySensorDetails(table->getSensor(i));
         cout << "\n\n--------------------------------------" << endl;
     }
 }
 
+void SystemManager::displaySensorsInIdRange() {
+    cout << "\n=== SENSORS IN ID RANGE ===" << endl;
+    
+    u_int32_t first = InputUtils::getNumberInRange(
+        "Enter first sensor ID (10000-99999): ", 10000, 99999);
+    u_int32_t last = InputUtils::getNumberInRange(
+        "Enter last sensor ID (" + to_string(first) + "-99999): ", 
+        first, 99999);
+    
+    SensorIdRange sensors = sensorDB.getSensorsInIdRange(first, last);
+    if (sensors.empty()) {
+        cout << "No sensors between " << first << " and " << last << "." << endl;
+        return;
+    }
+    
+    cout << sensors.size() << " sensor(s) between " << first 
+         << " and " << last << ":" << endl;
+    for (Sensor* sensor : sensors) {
+        cout << "\n";
+        displaySensorDetails(sensor);
+        cout << endl;
+    }
+}
+
 void SystemManager::addNewSensor() {
     if (!hasPermission("sensor_management")) return;
     
@@ -631,6 +687,53 @@ void SystemManager::addNewSensor() {
     }
 }
 
+// Bulk provisioning: the manifest picks types and counts, the database
+// picks free IDs and adds everything in one batch
+void SystemManager::provisionFromManifest() {
+    if (!hasPermission("sensor_management")) return;
+    
+    cout << "\n=== PROVISION SENSORS FROM MANIFEST ===" << endl;
+    cout << "One line per group: <type> <count> [<firstId> <lastId>]" << endl;
+    
+    try {
+        string filename = InputUtils::getValidatedString(
+            "Enter manifest file: ",
+            [](const string& s) { return !s.empty(); },
+            "File name cannot be empty");
+        
+        SensorManifest manifest = SensorManifest::load(filename.c_str());
+        if (manifest.empty()) {
+            cout << "Manifest lists no sensors." << endl;
+            return;
+        }
+        
+        for (const SensorManifest::Entry& entry : manifest.getEntries()) {
+            cout << "  " << setw(15) << left 
+                 << SensorManifest::typeName(entry.type) << right 
+                 << setw(7) << entry.count << "  in " << entry.firstId 
+                 << "-" << entry.lastId << endl;
+        }
+        
+        if (!InputUtils::getConfirmation("Provision " + 
+                to_string(manifest.getSensorCount()) + " sensor(s)?")) {
+            cout << "Provisioning cancelled." << endl;
+            return;
+        }
+        
+        auto start = chrono::steady_clock::now();
+        size_t added = sensorDB.provision(manifest);
+        long long ms = chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - start).count();
+        
+        cout << "✓ " << added << " sensor(s) provisioned in " << ms 
+             << " ms" << endl;
+        cout << "New sensors read 0 until their first data collection." << endl;
+        
+    } catch (const exception& e) {
+        cout << "Error provisioning sensors: " << e.what() << endl;
+    }
+}
+
 void SystemManager::updateExistingSensor() {
     if (!hasPermission("sensor_management")) return;
     
@@ -668,14 +771,12 @@ void SystemManager::updateExistingSensor() {
         if (InputUtils::getConfirmation("Change sensor ID from " 
                                          + to_string(currentId) + 
                                          " to " + to_string(newId) + "?")) {
-            sensor->setSensorId(newId);
-            
-            if (sensorDB.updateSensor(sensor)) {
+            // Goes through the database so its ID index stays in sync
+            if (sensorDB.changeSensorId(sensor, newId)) {
                 cout << "✓ Sensor ID updated successfully!" << endl;
                 displaySensorDetails(sensor);
             } else {
                 cout << "✗ Failed to update sensor ID!" << endl;
-                sensor->setSensorId(currentId); // Restore original ID
             }
         } else {
             cout << "ID change cancelled." << endl;
@@ -744,63 +845,50 @@ void SystemManager::findSensorById() {
 void SystemManager::collectSensorData() {
     cout << "\n=== COLLECT SENSOR DATA ===" << endl;
     
-    auto sensors = sensorDB.getAllSensors();
-    
-    if (sensors.empty()) {
+    size_t count = sensorDB.getSensorCount();
+    if (count == 0) {
         cout << "No sensors available for data collection." << endl;
         return;
     }
     
-    cout << "Starting data collection from " 
-         << sensors.size() << " sensor(s)..." << endl;
+    cout << "Starting data collection from " << count << " sensor(s) on " 
+         << collector.getThreadCount() << " thread(s)..." << endl;
     cout << "==========================================" << endl;
     
-    for (size_t i = 0; i < sensors.size(); ++i) {
-        auto sensor = sensors[i];
-        
-        cout << "\n[" << (i + 1) << "/" << sensors.size() 
-             << "] Processing Sensor ID " << sensor->getSensorId();
-        
-        if (sensor->isPrimarySensor() && 
-            (sensor->getType() == Sensor::TEMPERATURE 
-             || sensor->getType() == Sensor::CONTACT)) {
-            cout << " [MASTER SENSOR]";
-        } else if (sensor->isPrimarySensor()) {
-            cout << " [PRIMARY SENSOR]";
-        }
-        cout << endl;
-        
-        cout << "\n  BEFORE: ";
-        displaySensorDetails(sensor);
-        
-        cout << "  Collecting new data..." << endl;
-        sensor->collectData();
-        
-        cout << "  AFTER:  ";
-        displaySensorDetails(sensor);
-        
-        // Show coordination info for master sensors
-        if (sensor->isPrimarySensor()) {
-            if (sensor->getType() == Sensor::TEMPERATURE) {
-                cout << "  → Global temperature: " 
-                     << SensorCoordinator::getGlobalTemperature() << "°C\n";
-            }
-            if (sensor->getType() == Sensor::CONTACT) {
-                cout << "  → Movement status: " 
-                     << (SensorCoordinator::isMovementDetected() 
-                         ? "DETECTED" : "NONE") << endl;
-            }
-        }
-        
-        if (i < sensors.size() - 1) {
-            cout << " \n ------------------------------------------" << endl;
-            sleep(1); // Brief pause for readability
-        }
+    // Masters first, then every other sensor in parallel
+    const CollectionEngine::CycleStats& cycle = collector.runCycle();
+    
+    // Show the masters and the state they published for the cameras
+    Sensor* masterTemp = sensorDB.findSensorById(
+        TemperatureSensor::PRIMARY_TEMP_ID);
+    if (masterTemp) {
+        cout << "\n[MASTER SENSOR] ";
+        displaySensorDetails(masterTemp);
+        cout << "\n  → Global temperature: " 
+             << SensorCoordinator::getGlobalTemperature() << "°C" << endl;
+    }
+    Sensor* masterContact = sensorDB.findSensorById(
+        ContactSensor::PRIMARY_CONTACT_ID);
+    if (masterContact) {
+        cout << "\n[MASTER SENSOR] ";
+        displaySensorDetails(masterContact);
+        cout << "\n  → Movement status: " 
+             << (SensorCoordinator::isMovementDetected() ? "DETECTED" : "NONE") 
+             << endl;
     }
     
+    // One fsync for the whole collection cycle
+    sensorDB.commitLog();
+    
     cout << "\n==========================================" << endl;
     cout << "✓ Data collection completed successfully!" << endl;
-    cout << "  Total sensors processed: " << sensors.size() << endl;
+    cout << "  Total sensors processed: " << cycle.sensors << endl;
+    cout << "  Primary sensors (masters first): " << cycle.primaries 
+         << " in " << cycle.primaryMs << " ms" << endl;
+    cout << "  Other sensors (" << cycle.threads << " thread(s)): " 
+         << cycle.parallelMs << " ms" << endl;
+    cout << "  Recording readings: " << cycle.recordMs << " ms" << endl;
+    cout << "  Cycle wall time: " << cycle.totalMs << " ms" << endl;
 }
 
 void SystemManager::clearSensorDatabase() {
@@ -881,21 +969,63 @@ void SystemManager::showMonitoringDashboard() {
     cout << "2. Collect all sensor data" << endl;
     cout << "3. Check security alarm" << endl;
     cout << "4. Test sensor coordination" << endl;
+    cout << "5. Display sensor history" << endl;
     cout << "0. Back to main menu" << endl;
     
-    int choice = InputUtils::getNumberInRange("Select option: ", 0, 4);
+    int choice = InputUtils::getNumberInRange("Select option: ", 0, 5);
     
     switch (choice) {
         case 1: displaySystemStatus(); break;
         case 2: collectSensorData(); break;
         case 3: checkSecurityAlarm(); break;
         case 4: testSensorCoordination(); break;
+        case 5: displaySensorHistory(); break;
         case 0: return;
     }
     
     InputUtils::pauseExecution();
 }
 
+void SystemManager::displaySensorHistory() {
+    cout << "\n=== SENSOR HISTORY ===" << endl;
+    
+    u_int32_t sensorId = InputUtils::getNumberInRange(
+        "Enter sensor ID (10000-99999): ", 10000, 99999);
+    u_int32_t minutes = InputUtils::getNumberInRange(
+        "Show the last N minutes (1-1440): ", 1, 1440);
+    
+    const ReadingHistory& history = sensorDB.getHistory();
+    int64_t to = ReadingHistory::now();
+    int64_t from = to - static_cast<int64_t>(minutes) * 60 * 1000;
+    
+    size_t shown = 0;
+    for (const ReadingHistory::Sample& sample : 
+             history.range(sensorId, from, to)) {
+        cout << "  -" << (to - sample.timestamp) / 1000 << "s: ";
+        if (sample.width == 1) {
+            cout << sample.values[0];
+        } else {
+            // Camera frame: first pixels only
+            for (size_t i = 0; i < 4 && i < sample.width; i++) {
+                cout << sample.values[i] << " ";
+            }
+            cout << "... (" << sample.width << " values)";
+        }
+        cout << endl;
+        shown++;
+    }
+    
+    if (shown == 0) {
+        cout << "No readings recorded for sensor " << sensorId 
+             << " in that period." << endl;
+    } else {
+        cout << shown << " reading(s), " 
+             << history.sampleCount(sensorId) << " kept in total" << endl;
+    }
+    cout << "History memory: " << history.memoryBytes() << " bytes in " 
+         << history.seriesCount() << " series" << endl;
+}
+
 void SystemManager::showSecuritySystem() {
     cout << "\n=== SECURITY SYSTEM ===" << endl;
     cout << "1. Force security check" << endl;
@@ -909,18 +1039,16 @@ void SystemManager::showSecuritySystem() {
         case 1: checkSecurityAlarm(); break;
         case 2: 
             cout << "\n=== CONTACT SENSORS ===" << endl;
-            for (auto sensor : sensorDB.getAllSensors()) {
-                if (sensor->getType() == Sensor::CONTACT) {
-                    displaySensorDetails(sensor);
-                }
+            for (auto sensor : sensorDB.getSensorsOfType(Sensor::CONTACT)) {
+                displaySensorDetails(sensor);
             }
+            cout << "Open: " << sensorDB.getContactStates().countOpen() 
+                 << " of " << sensorDB.getContactStates().size() << endl;
             break;
         case 3:
             cout << "\n=== CAMERA SYSTEMS ===" << endl;
-            for (auto sensor : sensorDB.getAllSensors()) {
-                if (sensor->getType() == Sensor::RGB_CAMERA) {
-                    displaySensorDetails(sensor);
-                }
+            for (auto camera : sensorDB.getSensorsOfType<RGBCamera>()) {
+                displaySensorDetails(camera);
             }
             break;
         case 0: return;
@@ -950,13 +1078,20 @@ void SystemManager::displaySystemStatus() {
     cout << "\n=== SYSTEM STATUS OVERVIEW ===" << endl;
     cout << "=========================================" << endl;
     
-    auto sensors = sensorDB.getAllSensors();
-    auto users = userDB.getAllUsers();
+    // Sensor figures come from one pinned version, so they are consistent
+    // with each other even while writers are active. Every figure is a
+    // maintained aggregate: nothing here walks the sensors or users
+    SensorTableVersion::Pin table = sensorDB.pinVersion();
+    const SensorAggregates& aggregates = table->getAggregates();
     
     // General statistics
     cout << "📊 SYSTEM STATISTICS:" << endl;
-    cout << "  Registered sensors: " << sensors.size() << endl;
-    cout << "  Registered users: " << users.size() << endl;
+    cout << "  Registered sensors: " << aggregates.getSensorCount() << " (" 
+         << aggregates.getPrimaryCount() << " primary, " 
+         << aggregates.getRegularCount() << " regular)" << endl;
+    cout << "  Registered users: " << userDB.getUserCount() << " (" 
+         << userDB.countUsersWithRole(User::ADMIN) 
+         << " administrators)" << endl;
     cout << "  Current user: ";
     if (currentUser) {
         string currentUserNumber = to_string(currentUser->getuserNumber());
@@ -981,20 +1116,22 @@ void SystemManager::displaySystemStatus() {
     
     // Sensor breakdown by type
     cout << "\n📡 SENSOR BREAKDOWN:" << endl;
-    int sensorCounts[7] = {0}; // Array for each sensor type
-    
-    for (auto sensor : sensors) {
-        sensorCounts[sensor->getType()]++;
+    const char* typeNames[Sensor::TYPE_COUNT] = {
+        "Hygrometers", "Air Quality", "Lux Meters", "Temperature", 
+        "Contact", "Thermal Cameras", "RGB Cameras"
+    };
+    
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        const SensorAggregates::TypeStats& stats = 
+            aggregates.forType(static_cast<Sensor::Type>(type));
+        cout << "  " << typeNames[type] << ": " << stats.sensors;
+        if (stats.readings > 0) {
+            cout << "  (readings min " << stats.minValue << ", max " 
+                 << stats.maxValue << ", last " << stats.lastValue << ")";
+        }
+        cout << endl;
     }
     
-    cout << "  Hygrometers: " << sensorCounts[Sensor::HYGROMETER] << endl;
-    cout << "  Air Quality: " << sensorCounts[Sensor::AIR_QUALITY] << endl;
-    cout << "  Lux Meters: " << sensorCounts[Sensor::LUX_METER] << endl;
-    cout << "  Temperature: " << sensorCounts[Sensor::TEMPERATURE] << endl;
-    cout << "  Contact: " << sensorCounts[Sensor::CONTACT] << endl;
-    cout << "  Thermal Cameras: " << sensorCounts[Sensor::THERMAL_CAMERA];
-    cout << "  \nRGB Cameras: " << sensorCounts[Sensor::RGB_CAMERA] << endl;
-    
     cout << "\n=========================================" << endl;
 }
 
@@ -1009,9 +1146,13 @@ void SystemManager::showSystemMaintenance() {
     cout << "3. Display system statistics" << endl;
     cout << "4. Clear all databases" << endl;
     cout << "5. Initialize default data" << endl;
+    cout << "6. Convert sensor file format" << endl;
+    cout << "7. Configure background snapshots" << endl;
+    cout << "8. Configure periodic sampling" << endl;
+    cout << "9. Select hardware source" << endl;
     cout << "0. Back to main menu" << endl;
     
-    int choice = InputUtils::getNumberInRange("Select option: ", 0, 5);
+    int choice = InputUtils::getNumberInRange("Select option: ", 0, 9);
     
     switch (choice) {
         case 1: saveAllDatabases(); break;
@@ -1032,6 +1173,10 @@ void SystemManager::showSystemMaintenance() {
                 cout << "✓ Default data initialized" << endl;
             }
             break;
+        case 6: convertSensorFileFormat(); break;
+        case 7: configureSnapshots(); break;
+        case 8: configureSampling(); break;
+        case 9: configureHardwareSource(); break;
         case 0: return;
     }
     
@@ -1082,6 +1227,173 @@ void SystemManager::loadAllDatabases() {
     }
 }
 
+// Switch sensors.dat between the legacy fixed records and the compact format
+void SystemManager::convertSensorFileFormat() {
+    cout << "\n=== CONVERT SENSOR FILE FORMAT ===" << endl;
+    
+    SensorFileFormat::Format current = sensorDB.getFileFormat();
+    SensorFileFormat::Format target = (current == SensorFileFormat::COMPACT)
+                                    ? SensorFileFormat::FIXED_RECORDS
+                                    : SensorFileFormat::COMPACT;
+    cout << "Current format: " << SensorFileFormat::formatName(current) << endl;
+    
+    string prompt = string("Convert to ") + 
+                    SensorFileFormat::formatName(target) + "?";
+    if (!InputUtils::getConfirmation(prompt)) {
+        return;
+    }
+    
+    try {
+        if (sensorDB.setFileFormat(target)) {
+            cout << "✓ Sensor file converted (" << sensorDB.getLastSaveBytes() 
+                 << " bytes)" << endl;
+        } else {
+            cout << "✗ Sensor file conversion failed" << endl;
+        }
+    } catch (const exception& e) {
+        cout << "Error converting sensor file: " << e.what() << endl;
+    }
+}
+
+void SystemManager::configureSnapshots() {
+    cout << "\n=== BACKGROUND SNAPSHOTS ===" << endl;
+    
+    unsigned cadence = sensorDB.getSnapshotCadence();
+    if (cadence == 0) {
+        cout << "Current mode: inline checkpoints" << endl;
+    } else {
+        cout << "Current cadence: every " << cadence << " s" << endl;
+    }
+    
+    u_int32_t seconds = InputUtils::getNumberInRange(
+        "New cadence in seconds (0 = inline, max 3600): ", 0, 3600);
+    sensorDB.setSnapshotCadence(seconds);
+    
+    if (seconds == 0) {
+        cout << "✓ Background snapshots disabled" << endl;
+    } else {
+        cout << "✓ Snapshots every " << seconds << " s" << endl;
+    }
+}
+
+void SystemManager::configureSampling() {
+    cout << "\n=== PERIODIC SAMPLING ===" << endl;
+    cout << "Status: " << (sampler.isRunning() ? "running" : "stopped") 
+         << " (" << sampler.getThreadCount() << " thread(s), " 
+         << SamplingScheduler::TICK_MS << " ms ticks)" << endl;
+    cout << "Periods by type:" << endl;
+    for (size_t type = 0; type < Sensor::TYPE_COUNT; type++) {
+        Sensor::Type sensorType = static_cast<Sensor::Type>(type);
+        cout << "  " << type << "=" << SensorManifest::typeName(sensorType) 
+             << ": " << sampler.getTypePeriod(sensorType) << " ms" << endl;
+    }
+    
+    cout << "\n1. " << (sampler.isRunning() ? "Stop" : "Start") 
+         << " sampling" << endl;
+    cout << "2. Set period of a sensor type" << endl;
+    cout << "3. Set period of one sensor" << endl;
+    cout << "4. Reset sampling statistics" << endl;
+    cout << "0. Back" << endl;
+    
+    int choice = InputUtils::getNumberInRange("Select option: ", 0, 4);
+    
+    try {
+        switch (choice) {
+            case 1:
+                if (sampler.isRunning()) {
+                    sampler.stop();
+                    cout << "✓ Periodic sampling stopped" << endl;
+                } else {
+                    sampler.start();
+                    cout << "✓ Periodic sampling started" << endl;
+                }
+                break;
+            case 2: {
+                int sensorType = 
+                    InputUtils::getNumberInRange("Enter type (0-6): ", 0, 6);
+                u_int32_t period = InputUtils::getNumberInRange(
+                    "Period in ms (0 = default): ", 0, 
+                    SamplingScheduler::MAX_PERIOD_MS);
+                Sensor::Type type = static_cast<Sensor::Type>(sensorType);
+                sampler.setTypePeriod(type, period);
+                cout << "✓ " << SensorManifest::typeName(type) 
+                     << " sensors sampled every " 
+                     << sampler.getTypePeriod(type) << " ms" << endl;
+                break;
+            }
+            case 3: {
+                u_int32_t sensorId = InputUtils::getNumberInRange(
+                    "Enter sensor ID (10000-99999): ", 10000, 99999);
+                u_int32_t period = InputUtils::getNumberInRange(
+                    "Period in ms (0 = its type's): ", 0, 
+                    SamplingScheduler::MAX_PERIOD_MS);
+                if (sampler.setSensorPeriod(sensorId, period)) {
+                    cout << "✓ Sensor " << sensorId << " sampled every " 
+                         << sampler.getSensorPeriod(sensorId) << " ms" << endl;
+                } else {
+                    cout << "✗ Sensor with ID " << sensorId 
+                         << " not found." << endl;
+                }
+                break;
+            }
+            case 4:
+                sampler.resetStats();
+                cout << "✓ Sampling statistics reset" << endl;
+                break;
+            case 0: return;
+        }
+    } catch (const exception& e) {
+        cout << "Error configuring sampling: " << e.what() << endl;
+    }
+}
+
+// Sampling is paused while this runs, so the source can be swapped
+void SystemManager::configureHardwareSource() {
+    cout << "\n=== HARDWARE SOURCE ===" << endl;
+    cout << "Current source: " << HardwareSource::current().describe() << endl;
+    
+    cout << "\n1. Simulated readings (fixed seed)" << endl;
+    cout << "2. Replay readings from a file" << endl;
+    cout << "0. Back" << endl;
+    
+    int choice = InputUtils::getNumberInRange("Select option: ", 0, 2);
+    
+    try {
+        switch (choice) {
+            case 1: {
+                u_int32_t seed = InputUtils::getNumberInRange(
+                    "Seed (0-999999999): ", 0, 999999999);
+                HardwareSource::install(nullptr);
+                delete replay;
+                replay = nullptr;
+                HardwareSource::simulator().reseed(seed);
+                cout << "✓ Readings simulated from seed " << seed << endl;
+                break;
+            }
+            case 2: {
+                cout << "One reading per line: <sensorId> <value> [<value> ...]" 
+                     << endl;
+                string filename = InputUtils::getValidatedString(
+                    "Enter replay file: ",
+                    [](const string& s) { return !s.empty(); },
+                    "File name cannot be empty");
+                
+                // Sensors missing from the file stay simulated
+                ReplayHardware* loaded = new ReplayHardware(
+                    filename.c_str(), HardwareSource::simulator());
+                HardwareSource::install(loaded);
+                delete replay;
+                replay = loaded;
+                cout << "✓ " << replay->describe() << endl;
+                break;
+            }
+            case 0: return;
+        }
+    } catch (const exception& e) {
+        cout << "Error selecting hardware source: " << e.what() << endl;
+    }
+}
+
 void SystemManager::displaySystemStatistics() {
     cout << "\n=== SYSTEM STATISTICS ===" << endl;
     cout << "=========================================" << endl;
@@ -1094,12 +1406,72 @@ void SystemManager::displaySystemStatistics() {
     cout << "\nMemory Statistics:" << endl;
     cout << "  User count: " << User::getUserCount() << endl;
     cout << "  Sensor count: " << Sensor::getSensorCount() << endl;
+    SlabPool::Stats sensorPools = SensorFactory::poolStats();
+    SlabPool::Stats userPools = UserFactory::poolStats();
+    cout << "  Sensor pools: " << sensorPools.slabCount << " slab(s), " 
+         << sensorPools.reservedBytes / 1024 << " KB reserved" << endl;
+    cout << "  User pools: " << userPools.slabCount << " slab(s), " 
+         << userPools.reservedBytes / 1024 << " KB reserved" << endl;
     
     cout << "\nDatabase Statistics:" << endl;
-    auto users = userDB.getAllUsers();
-    auto sensors = sensorDB.getAllSensors();
-    cout << "  Users in database: " << users.size() << endl;
-    cout << "  Sensors in database: " << sensors.size() << endl;
+    cout << "  Users in database: " << userDB.getUserCount() << " (" 
+         << userDB.countUsersWithRole(User::ADMIN) << " admin, " 
+         << userDB.countUsersWithRole(User::EMPLOYEE) << " employee)" << endl;
+    cout << "  Sensors in database: " << sensorDB.getSensorCount() << " (" 
+         << sensorDB.getAggregates().getPrimaryCount() << " primary)" << endl;
+    cout << "  Published read version: " << sensorDB.pinVersion()->getVersion() 
+         << endl;
+    
+    // Read-only statistics straight from the mapped file (no Sensor objects)
+    cout << "\nPersisted Sensor File:" << endl;
+    SensorFileView sensorFile(sensorDB.getFilename());
+    if (sensorFile.isOpen()) {
+        size_t persistedByType[Sensor::TYPE_COUNT] = {0};
+        for (const SensorRecord& record : sensorFile) {
+            if (SensorFactory::isValidRecord(record)) {
+                persistedByType[record.sensorType]++;
+            }
+        }
+        cout << "  Format: " 
+             << SensorFileFormat::formatName(sensorFile.format()) << endl;
+        cout << "  File size: " << sensorFile.fileSize() << " bytes" << endl;
+        cout << "  Records on disk: " << sensorFile.recordCount() << endl;
+        cout << "  Cameras on disk: " 
+             << persistedByType[Sensor::THERMAL_CAMERA] 
+                + persistedByType[Sensor::RGB_CAMERA] << endl;
+    } else {
+        cout << "  Sensor file not available" << endl;
+    }
+    
+    cout << "\nBackground Snapshots:" << endl;
+    Snapshotter::Stats snapshotStats;
+    if (sensorDB.getSnapshotStats(snapshotStats)) {
+        cout << "  Cadence: " << sensorDB.getSnapshotCadence() << " s" << endl;
+        cout << "  Snapshots written: " << snapshotStats.completed 
+             << " (" << snapshotStats.failed << " failed)" << endl;
+        cout << "  Last snapshot: " << snapshotStats.lastBytes << " bytes in " 
+             << snapshotStats.lastDurationMs << " ms" << endl;
+        cout << "  Total written: " << snapshotStats.totalBytes 
+             << " bytes" << endl;
+    } else {
+        cout << "  Disabled (inline checkpoints)" << endl;
+    }
+    
+    cout << "\nPeriodic Sampling:" << endl;
+    SamplingScheduler::Stats samplingStats = sampler.getStats();
+    cout << "  Status: " << (sampler.isRunning() ? "Running" : "Stopped") 
+         << ", " << samplingStats.scheduledSensors << " sensor(s) scheduled" 
+         << endl;
+    cout << "  Samples taken: " << samplingStats.samples << " in " 
+         << samplingStats.ticks << " tick(s) (" 
+         << samplingStats.missedPeriods << " period(s) missed)" << endl;
+    cout << "  Lateness: " << samplingStats.meanLatenessMs << " ms mean, " 
+         << samplingStats.maxLatenessMs << " ms max" << endl;
+    cout << "  Jitter: " << samplingStats.meanJitterMs << " ms mean, " 
+         << samplingStats.maxJitterMs << " ms max" << endl;
+    cout << "  Last tick: " << samplingStats.lastTickMs << " ms" << endl;
+    cout << "  Hardware source: " << HardwareSource::current().describe() 
+         << endl;
     
     cout << "\nSensor Coordination:" << endl;
     cout << "  Global temperature: " 
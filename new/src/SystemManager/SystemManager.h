@@ -5,6 +5,9 @@
 #include "../Databases/SensorDatabase.h"
 #include "../AlarmSystem/AlarmSystem.h"
 #include "../Sensors/Coordination/SensorCoordinator.h"
+#include "../Sensors/Coordination/CollectionEngine.h"
+#include "../Sensors/Coordination/SamplingScheduler.h"
+#include "../Sensors/Hardware/ReplayHardware.h"
 #include "../Users/User.h"
 #include "../Sensors/Sensor.h"
 #include <string>
@@ -37,6 +40,10 @@ private:
     // Core system components
     UserDatabase userDB;
     SensorDatabase sensorDB;
+    CollectionEngine collector;   // Parallel collection cycles on sensorDB
+    SamplingScheduler sampler;    // Periodic sampling while menus wait,
+                                  // on the collector's worker threads
+    ReplayHardware* replay;       // Installed hardware source, if a replay
     AlarmSystem* alarmSystem;
     User* currentUser;
     bool systemRunning;
@@ -62,17 +69,20 @@ private:
     void showSensorManagement();
     void displaySensorList();
     void addNewSensor();
+    void provisionFromManifest();
     void updateExistingSensor();
     void removeSensor();
     void findSensorById();
     void collectSensorData();
     void clearSensorDatabase();
     void testSensorCoordination();
+    void displaySensorsInIdRange();
     
     // === MONITORING AND SECURITY ===
     void showMonitoringDashboard();
     void showSecuritySystem();
     void checkSecurityAlarm();
+    void displaySensorHistory();
     
     // === SYSTEM MAINTENANCE ===
     void showSystemMaintenance();
@@ -80,6 +90,10 @@ private:
     void loadAllDatabases();
     void displaySystemStatistics();
     void displaySystemStatus();
+    void convertSensorFileFormat();
+    void configureSnapshots();
+    void configureSampling();
+    void configureHardwareSource();
 
     // Utility and helper methods
     void displayWelcomeMessage();
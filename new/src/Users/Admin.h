@@ -2,10 +2,11 @@
 #define ADMIN_H
 
 #include "User.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class Admin : public User {
+class Admin : public User, public PoolAllocated<Admin> {
 public:
     Admin(u_int32_t userNumber, 
           const char* nif, 
@@ -2,10 +2,11 @@
 #define EMPLOYEE_H
 
 #include "User.h"
+#include "../Utils/SlabPool.h"
 
 using namespace std;
 
-class Employee : public User {
+class Employee : public User, public PoolAllocated<Employee> {
 public:
     Employee(u_int32_t userNumber, 
              const char* nif, 
@@ -22,6 +22,7 @@ public:
         ADMIN = 0,
         EMPLOYEE = 1
     };
+    static constexpr size_t ROLE_COUNT = 2;     // Number of values in 'Role'
     
     // Abstract Class - Pure Virtual Destructor
     virtual ~User() = 0;    
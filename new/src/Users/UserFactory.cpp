@@ -5,6 +5,9 @@
 
 using namespace std;
 
+// Out-of-line definition for the ODR-used constant
+constexpr u_int32_t UserFactory::TOMBSTONE_NUMBER;
+
 // Convert User to binary record
 UserRecord UserFactory::userToRecord(const User* user) {
     if (!user) {
@@ -48,6 +51,37 @@ User* UserFactory::recordToUser(const UserRecord& record) {
     }
 }
 
+// Check the fields of a raw record before converting it
+bool UserFactory::isValidRecord(const UserRecord& record) {
+    if (record.userNumber < User::MIN_USER_NUMBER || 
+        record.userNumber > User::MAX_USER_NUMBER) {
+        return false; // Invalid record: user number out of range
+    }
+    if (record.role != User::ADMIN && record.role != User::EMPLOYEE) {
+        return false; // Invalid record: unrecognized role
+    }
+    if (record.nif[0] == '\0') {
+        return false; // Invalid record: empty nif
+    }
+    if (record.pwd[0] == '\0') {
+        return false; // Invalid record: empty password
+    }
+    return true;
+}
+
+// Record left in the slot of a removed user
+UserRecord UserFactory::tombstoneRecord() {
+    UserRecord record;
+    memset(&record, 0, sizeof(record));
+    record.userNumber = TOMBSTONE_NUMBER;
+    return record;
+}
+
+bool UserFactory::isTombstone(const UserRecord& record) {
+    return record.userNumber == TOMBSTONE_NUMBER && 
+           record.nif[0] == '\0' && record.pwd[0] == '\0';
+}
+
 // Write User directly to binary file
 void UserFactory::writeUserToFile(std::ofstream& file, const User* user) {
     if (!file.is_open()) {
@@ -84,18 +118,8 @@ User* UserFactory::readUserFromFile(std::ifstream& file) {
     // Read binary record from file
     if (file.read(reinterpret_cast<char*>(&record), sizeof(UserRecord))) {
         // Multiple validations to ensure record integrity
-        if (record.userNumber < User::MIN_USER_NUMBER || 
-            record.userNumber > User::MAX_USER_NUMBER) {
-            return nullptr; // Invalid record: user number out of range
-        }
-        if (record.role != User::ADMIN && record.role != User::EMPLOYEE) {
-            return nullptr; // Invalid record: unrecognized role
-        }
-        if (record.nif[0] == '\0') {
-            return nullptr; // Invalid record: empty nif
-        }
-        if (record.pwd[0] == '\0') {
-            return nullptr; // Invalid record: empty password
+        if (!isValidRecord(record)) {
+            return nullptr;
         }
         // All validations passed, convert record to User object
         return recordToUser(record);
@@ -103,4 +127,20 @@ User* UserFactory::readUserFromFile(std::ifstream& file) {
     
     // End of file or read error occurred
     return nullptr;
-}
\ No newline at end of file
+}
+
+SlabPool::Stats UserFactory::poolStats() {
+    SlabPool::Stats admins = Admin::pool().getStats();
+    SlabPool::Stats employees = Employee::pool().getStats();
+    
+    SlabPool::Stats total;
+    total.liveObjects = admins.liveObjects + employees.liveObjects;
+    total.slabCount = admins.slabCount + employees.slabCount;
+    total.reservedBytes = admins.reservedBytes + employees.reservedBytes;
+    return total;
+}
+
+// Free the slabs emptied by removals (e.g. after clearing the database)
+size_t UserFactory::releaseUnusedMemory() {
+    return Admin::pool().trim() + Employee::pool().trim();
+}
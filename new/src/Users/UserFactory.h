@@ -18,13 +18,24 @@ struct UserRecord {
 
 class UserFactory {
 public:
+    static constexpr u_int32_t TOMBSTONE_NUMBER = 0; // Below MIN_USER_NUMBER
+    
     // Binary record conversion methods
     static UserRecord userToRecord(const User* user);
     static User* recordToUser(const UserRecord& record);
+    static bool isValidRecord(const UserRecord& record);
+    
+    // Tombstones mark freed slots of an in-place updated users.dat
+    static UserRecord tombstoneRecord();
+    static bool isTombstone(const UserRecord& record);
     
     // Methods for direct binary file access
     static void writeUserToFile(std::ofstream& file, const User* user);
     static User* readUserFromFile(std::ifstream& file);
+    
+    // Slab pools behind Admin and Employee (summed over both)
+    static SlabPool::Stats poolStats();
+    static size_t releaseUnusedMemory(); // Bytes returned to the system
 };
 
 #endif // USER_FACTORY_H
\ No newline at end of file
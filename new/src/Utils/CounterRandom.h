@@ -0,0 +1,50 @@
+#ifndef COUNTERRANDOM_H
+#define COUNTERRANDOM_H
+
+#include <cstddef>
+#include <sys/types.h>
+
+/**
+ * @brief Counter-based random numbers for simulated readings
+ *
+ * Every draw is a hash of where it is taken, with no generator state: a
+ * stream names one reading (seed, sensor, reading number) and draw 'k'
+ * of it is a hash of (stream, k). The same seed always gives the same
+ * readings, whichever thread takes them and in whatever order, a loop
+ * filling a buffer computes every element on its own and can be
+ * vectorized, and no lock is taken (rand() takes one per call).
+ */
+namespace CounterRandom {
+    // 32-bit integer hash (xor-shift-multiply, full avalanche)
+    inline u_int32_t hash(u_int32_t x) {
+        x ^= x >> 16;
+        x *= 0x7feb352dU;
+        x ^= x >> 15;
+        x *= 0x846ca68bU;
+        x ^= x >> 16;
+        return x;
+    }
+
+    // Stream of reading 'number' of 'element' under 'seed'
+    inline u_int32_t stream(u_int32_t seed, u_int32_t element,
+                            u_int32_t number) {
+        return hash(hash(seed ^ hash(element)) + number);
+    }
+
+    inline u_int32_t draw(u_int32_t stream, u_int32_t k) {
+        return hash(stream + k * 0x9e3779b9U);
+    }
+
+    // Uniform in [0, bound) (multiply-shift, no division)
+    inline int below(u_int32_t bits, u_int32_t bound) {
+        return static_cast<int>(
+            (static_cast<u_int64_t>(bits) * bound) >> 32);
+    }
+
+    // Draw 'k' of 'stream', uniform in [0, bound)
+    inline int uniform(u_int32_t stream, u_int32_t k, u_int32_t bound) {
+        return below(draw(stream, k), bound);
+    }
+}
+
+#endif // COUNTERRANDOM_H
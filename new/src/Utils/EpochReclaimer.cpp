@@ -0,0 +1,101 @@
+#include "EpochReclaimer.h"
+#include <thread>
+
+using namespace std;
+
+// Out-of-line definitions for the ODR-used constants
+constexpr size_t EpochReclaimer::MAX_READERS;
+constexpr u_int64_t EpochReclaimer::IDLE;
+
+EpochReclaimer::Guard::Guard(EpochReclaimer& reclaimer)
+    : reclaimer(reclaimer), slot(reclaimer.enter()) {
+}
+
+EpochReclaimer::Guard::~Guard() {
+    reclaimer.exit(slot);
+}
+
+// Epochs start at 1 so IDLE never matches a real epoch
+EpochReclaimer::EpochReclaimer() : globalEpoch(1) {
+    for (ReaderSlot& reader : readers) {
+        reader.claimed.store(false);
+        reader.epoch.store(IDLE);
+    }
+}
+
+EpochReclaimer::~EpochReclaimer() {
+    for (const Retired& entry : retired) {
+        entry.deleter(entry.object);
+    }
+}
+
+// Claim a free slot and announce the current epoch. The epoch is read
+// again after the announcement: if it moved, a writer may already have
+// scanned the slots, so announce the newer one
+size_t EpochReclaimer::enter() {
+    for (;;) {
+        for (size_t slot = 0; slot < MAX_READERS; slot++) {
+            bool expected = false;
+            if (readers[slot].claimed.compare_exchange_strong(expected, true)) {
+                u_int64_t epoch;
+                do {
+                    epoch = globalEpoch.load();
+                    readers[slot].epoch.store(epoch);
+                } while (globalEpoch.load() != epoch);
+                return slot;
+            }
+        }
+        this_thread::yield(); // Every slot taken: wait for a reader to leave
+    }
+}
+
+void EpochReclaimer::exit(size_t slot) {
+    readers[slot].epoch.store(IDLE);
+    readers[slot].claimed.store(false);
+}
+
+// The object must already be unreachable for new readers
+void EpochReclaimer::retire(void* object, Deleter deleter) {
+    if (object == nullptr) {
+        return;
+    }
+    lock_guard<mutex> lock(retiredMutex);
+    retired.push_back(Retired{object, deleter, globalEpoch.fetch_add(1)});
+}
+
+// A reader that announced epoch E started after every object retired
+// before E was unlinked, so those objects are safe to free
+size_t EpochReclaimer::reclaim() {
+    u_int64_t oldestReader = globalEpoch.load();
+    for (const ReaderSlot& reader : readers) {
+        u_int64_t epoch = reader.epoch.load();
+        if (epoch != IDLE && epoch < oldestReader) {
+            oldestReader = epoch;
+        }
+    }
+
+    vector<Retired> freeable;
+    {
+        lock_guard<mutex> lock(retiredMutex);
+        size_t kept = 0;
+        for (const Retired& entry : retired) {
+            if (entry.epoch < oldestReader) {
+                freeable.push_back(entry);
+            } else {
+                retired[kept++] = entry;
+            }
+        }
+        retired.resize(kept);
+    }
+
+    // Deleters run outside the lock
+    for (const Retired& entry : freeable) {
+        entry.deleter(entry.object);
+    }
+    return freeable.size();
+}
+
+size_t EpochReclaimer::pendingCount() const {
+    lock_guard<mutex> lock(retiredMutex);
+    return retired.size();
+}
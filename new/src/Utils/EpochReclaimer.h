@@ -0,0 +1,91 @@
+#ifndef EPOCHRECLAIMER_H
+#define EPOCHRECLAIMER_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <sys/types.h>
+
+/**
+ * @brief Epoch-based deferred deletion of objects readers may still hold
+ *
+ * Readers wrap every traversal in a Guard, which announces the global
+ * epoch they started in (one atomic store in a reader slot, no lock).
+ * Writers unlink an object and retire() it instead of deleting it: the
+ * object is tagged with the epoch at that moment and the epoch advances.
+ * reclaim() frees every retired object older than the oldest epoch still
+ * announced by a reader, i.e. objects no running traversal can have seen.
+ *
+ * Only object lifetime is covered: the containers readers walk must still
+ * be safe to read (or be immutable copies) while writers change them.
+ */
+class EpochReclaimer {
+public:
+    static constexpr size_t MAX_READERS = 64;  // Guards alive at once
+
+    typedef void (*Deleter)(void* object);
+
+    // Marks a reader critical section; non-copyable, nestable
+    class Guard {
+    public:
+        explicit Guard(EpochReclaimer& reclaimer);
+        ~Guard();
+
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+    private:
+        EpochReclaimer& reclaimer;
+        size_t slot;
+    };
+
+    EpochReclaimer();
+    ~EpochReclaimer(); // Frees whatever is still retired (no readers left)
+
+    // Non-copyable: readers point at the slots
+    EpochReclaimer(const EpochReclaimer&) = delete;
+    EpochReclaimer& operator=(const EpochReclaimer&) = delete;
+
+    // Defer 'delete object' until no reader can still see it
+    template <typename T>
+    void retire(T* object) {
+        retire(object, &deleteObject<T>);
+    }
+    void retire(void* object, Deleter deleter);
+
+    // Free what is safe to free now; returns the objects freed
+    size_t reclaim();
+    size_t pendingCount() const;
+
+private:
+    static constexpr u_int64_t IDLE = 0;   // Slot not in a critical section
+
+    struct ReaderSlot {
+        std::atomic<bool> claimed;
+        std::atomic<u_int64_t> epoch;      // Announced epoch, IDLE if none
+        char padding[64];                  // One slot per cache line
+    };
+
+    struct Retired {
+        void* object;
+        Deleter deleter;
+        u_int64_t epoch;
+    };
+
+    template <typename T>
+    static void deleteObject(void* object) {
+        delete static_cast<T*>(object);
+    }
+
+    size_t enter();
+    void exit(size_t slot);
+
+    std::atomic<u_int64_t> globalEpoch;
+    ReaderSlot readers[MAX_READERS];
+
+    mutable std::mutex retiredMutex;       // Writers only
+    std::vector<Retired> retired;
+};
+
+#endif // EPOCHRECLAIMER_H
@@ -2,6 +2,18 @@
 #include <iostream>
 #include <limits>
 
+namespace {
+    std::function<void()> beforeWait;
+    std::function<void()> afterWait;
+
+    // Blocking read of one line, between the wait hooks
+    void readLine(std::string& input) {
+        if (beforeWait) beforeWait();
+        std::getline(std::cin, input);
+        if (afterWait) afterWait();
+    }
+}
+
 namespace InputUtils {
     
     u_int32_t getNumberInRange(const std::string& prompt, 
@@ -12,7 +24,7 @@ namespace InputUtils {
         
         while (true) {
             std::cout << prompt;
-            std::getline(std::cin, input);
+            readLine(input);
             
             try {
                 unsigned long temp = std::stoul(input);
@@ -41,7 +53,7 @@ namespace InputUtils {
         
         while (true) {
             std::cout << prompt;
-            std::getline(std::cin, input);
+            readLine(input);
             
             if (validator(input)) {
                 return input;
@@ -56,7 +68,7 @@ namespace InputUtils {
         
         while (true) {
             std::cout << prompt << " (y/n): ";
-            std::getline(std::cin, input);
+            readLine(input);
             
             if (input.length() == 1) {
                 char c = std::tolower(input[0]);
@@ -70,6 +82,14 @@ namespace InputUtils {
 
     void pauseExecution() {
         std::cout << "\nPress Enter to continue...";
+        if (beforeWait) beforeWait();
         std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+        if (afterWait) afterWait();
+    }
+
+    void setWaitHooks(std::function<void()> before,
+                      std::function<void()> after) {
+        beforeWait = before;
+        afterWait = after;
     }
 }
\ No newline at end of file
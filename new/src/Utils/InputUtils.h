@@ -18,6 +18,11 @@ namespace InputUtils {
     bool getConfirmation(const std::string& prompt);
 
     void pauseExecution();
+
+    // Called right before and right after every wait for the user, e.g.
+    // to let background work use shared data meanwhile (empty = none)
+    void setWaitHooks(std::function<void()> beforeWait,
+                      std::function<void()> afterWait);
 }
 
 #endif // INPUTUTILS_H
\ No newline at end of file
@@ -0,0 +1,161 @@
+#include "SlabPool.h"
+#include <cstdlib>
+#include <cstddef>
+#include <algorithm>
+
+using namespace std;
+
+// Out-of-line definitions for the ODR-used constants
+constexpr size_t SlabPool::INITIAL_SLAB_OBJECTS;
+constexpr size_t SlabPool::MAX_SLAB_OBJECTS;
+
+namespace {
+    // Every object slot must fit a free-list link and keep the alignment
+    // malloc guarantees
+    size_t slotSize(size_t objectSize) {
+        const size_t alignment = alignof(max_align_t);
+        size_t size = max(objectSize, sizeof(void*));
+        return (size + alignment - 1) / alignment * alignment;
+    }
+}
+
+SlabPool::SlabPool(size_t objectSize) 
+    : objectSize(slotSize(objectSize)), current(nullptr), liveObjects(0),
+      reservedBytes(0) {
+}
+
+SlabPool::~SlabPool() {
+    // Objects may outlive the pool at program exit: leave their memory be
+    if (liveObjects == 0) {
+        while (!slabs.empty()) {
+            releaseSlab(slabs.begin()->second);
+        }
+    }
+}
+
+void* SlabPool::allocate() {
+    lock_guard<std::mutex> lock(stateMutex);
+    
+    if (current == nullptr || !hasRoom(current)) {
+        // Refill the lowest-addressed slab with room before growing
+        current = nullptr;
+        for (auto& entry : slabs) {
+            if (hasRoom(entry.second)) {
+                current = entry.second;
+                break;
+            }
+        }
+        if (current == nullptr) {
+            current = addSlab();
+        }
+    }
+    
+    void* object;
+    if (current->freeList) {
+        object = current->freeList;
+        current->freeList = current->freeList->next;
+    } else {
+        object = current->memory + current->used * objectSize;
+        current->used++;
+    }
+    current->live++;
+    liveObjects++;
+    return object;
+}
+
+void SlabPool::deallocate(void* object) {
+    lock_guard<std::mutex> lock(stateMutex);
+    
+    Slab* slab = findSlab(object);
+    if (slab == nullptr) {
+        return; // Not ours
+    }
+    
+    FreeObject* freed = static_cast<FreeObject*>(object);
+    freed->next = slab->freeList;
+    slab->freeList = freed;
+    slab->live--;
+    liveObjects--;
+    
+    // Last object gone: hand every slab back at once
+    if (liveObjects == 0) {
+        while (!slabs.empty()) {
+            releaseSlab(slabs.begin()->second);
+        }
+    }
+}
+
+size_t SlabPool::trim() {
+    lock_guard<std::mutex> lock(stateMutex);
+    
+    size_t before = reservedBytes;
+    for (auto it = slabs.begin(); it != slabs.end(); ) {
+        Slab* slab = it->second;
+        ++it; // releaseSlab() erases the entry
+        if (slab->live == 0) {
+            releaseSlab(slab);
+        }
+    }
+    return before - reservedBytes;
+}
+
+SlabPool::Stats SlabPool::getStats() const {
+    lock_guard<std::mutex> lock(stateMutex);
+    
+    Stats stats;
+    stats.liveObjects = liveObjects;
+    stats.slabCount = slabs.size();
+    stats.reservedBytes = reservedBytes;
+    return stats;
+}
+
+// Slab whose memory contains 'object', O(log #slabs)
+SlabPool::Slab* SlabPool::findSlab(void* object) const {
+    char* address = static_cast<char*>(object);
+    auto it = slabs.upper_bound(address);
+    if (it == slabs.begin()) {
+        return nullptr;
+    }
+    --it;
+    Slab* slab = it->second;
+    if (address >= slab->memory + slab->capacity * objectSize) {
+        return nullptr;
+    }
+    return slab;
+}
+
+// Each new slab doubles the pool's capacity, up to MAX_SLAB_OBJECTS
+SlabPool::Slab* SlabPool::addSlab() {
+    size_t capacity = reservedBytes / objectSize;
+    capacity = min(max(capacity, INITIAL_SLAB_OBJECTS), MAX_SLAB_OBJECTS);
+    
+    char* memory = static_cast<char*>(malloc(capacity * objectSize));
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    
+    Slab* slab = new Slab;
+    slab->memory = memory;
+    slab->capacity = capacity;
+    slab->used = 0;
+    slab->live = 0;
+    slab->freeList = nullptr;
+    
+    slabs[memory] = slab;
+    reservedBytes += capacity * objectSize;
+    return slab;
+}
+
+void SlabPool::releaseSlab(Slab* slab) {
+    if (slab == current) {
+        current = nullptr;
+    }
+    slabs.erase(slab->memory);
+    reservedBytes -= slab->capacity * objectSize;
+    free(slab->memory);
+    delete slab;
+}
+
+bool SlabPool::hasRoom(const Slab* slab) {
+    return slab->freeList != nullptr || slab->used < slab->capacity;
+}
@@ -0,0 +1,111 @@
+#ifndef SLABPOOL_H
+#define SLABPOOL_H
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+
+/**
+ * @brief Fixed-size object allocator backed by large slabs
+ *
+ * Objects of one size are carved out of slabs holding many objects each,
+ * so thousands of sensors cost a handful of malloc calls and objects
+ * created together sit next to each other in memory. Slabs start small
+ * (INITIAL_SLAB_OBJECTS) and double up to MAX_SLAB_OBJECTS, so a pool
+ * holding a few primary sensors stays small.
+ *
+ * Freed objects go to their slab's free list. Slabs left without live
+ * objects are returned to the system in bulk by trim(), and automatically
+ * once the whole pool is empty.
+ *
+ * Thread-safe: each pool has its own mutex.
+ */
+class SlabPool {
+public:
+    static constexpr size_t INITIAL_SLAB_OBJECTS = 32;
+    static constexpr size_t MAX_SLAB_OBJECTS = 4096;
+
+    struct Stats {
+        size_t liveObjects;    // Allocated and not yet freed
+        size_t slabCount;      // Slabs currently held
+        size_t reservedBytes;  // Memory held by those slabs
+    };
+
+    explicit SlabPool(size_t objectSize);
+    ~SlabPool(); // Slabs still holding objects are left alone
+
+    // Non-copyable: owns the slabs
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    void* allocate();             // Throws bad_alloc like operator new
+    void deallocate(void* object);
+
+    // Return every empty slab to the system; returns the bytes released
+    size_t trim();
+
+    Stats getStats() const;
+
+private:
+    struct FreeObject {
+        FreeObject* next;
+    };
+
+    struct Slab {
+        char* memory;
+        size_t capacity;      // Objects in this slab
+        size_t used;          // Objects handed out at least once (bump)
+        size_t live;
+        FreeObject* freeList;
+    };
+
+    Slab* findSlab(void* object) const;
+    Slab* addSlab();
+    void releaseSlab(Slab* slab);
+    static bool hasRoom(const Slab* slab);
+
+    mutable std::mutex stateMutex;
+    size_t objectSize;
+    std::map<char*, Slab*> slabs;  // By start address, for deallocate()
+    Slab* current;                 // Slab allocations are served from
+    size_t liveObjects;
+    size_t reservedBytes;
+};
+
+/**
+ * @brief Per-concrete-type pool allocation (CRTP)
+ *
+ * Deriving 'class T : public Base, public PoolAllocated<T>' routes every
+ * 'new T' and 'delete' of a T (also through a base pointer with a virtual
+ * destructor) to a SlabPool holding only T objects. Subclasses of T with a
+ * different size fall back to the global heap.
+ */
+template <typename T>
+class PoolAllocated {
+public:
+    static void* operator new(size_t size) {
+        if (size != sizeof(T)) {
+            return ::operator new(size);
+        }
+        return pool().allocate();
+    }
+
+    static void operator delete(void* object, size_t size) {
+        if (object == nullptr) {
+            return;
+        }
+        if (size != sizeof(T)) {
+            ::operator delete(object);
+            return;
+        }
+        pool().deallocate(object);
+    }
+
+    static SlabPool& pool() {
+        static SlabPool instance(sizeof(T));
+        return instance;
+    }
+};
+
+#endif // SLABPOOL_H
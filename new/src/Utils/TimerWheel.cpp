@@ -0,0 +1,114 @@
+#include "TimerWheel.h"
+#include <stdexcept>
+
+using namespace std;
+
+// Out-of-line definition for the ODR-used constant
+constexpr int32_t TimerWheel::NO_NODE;
+
+TimerWheel::TimerWheel(size_t capacity)
+    : nodes(capacity, Node{NO_NODE, NO_NODE, NO_NODE, 0}),
+      heads(LEVELS * SLOTS, NO_NODE), current(0), pending(0) {
+}
+
+void TimerWheel::schedule(u_int32_t key, u_int64_t delay) {
+    if (key >= nodes.size()) {
+        throw out_of_range("Timer key out of range");
+    }
+    if (delay == 0) {
+        delay = 1;
+    } else if (delay > MAX_DELAY) {
+        delay = MAX_DELAY;
+    }
+    if (nodes[key].slot != NO_NODE) {
+        unlink(key);
+        pending--;
+    }
+    nodes[key].expiry = current + delay;
+    link(key);
+    pending++;
+}
+
+bool TimerWheel::cancel(u_int32_t key) {
+    if (!isScheduled(key)) {
+        return false;
+    }
+    unlink(key);
+    pending--;
+    return true;
+}
+
+bool TimerWheel::isScheduled(u_int32_t key) const {
+    return key < nodes.size() && nodes[key].slot != NO_NODE;
+}
+
+void TimerWheel::tick(vector<u_int32_t>& expired) {
+    current++;
+
+    // Bring down the slots whose span starts now, lowest level first
+    for (unsigned level = 1; level < LEVELS; level++) {
+        u_int64_t span = (u_int64_t(1) << (LEVEL_BITS * level)) - 1;
+        if (current & span) {
+            break;
+        }
+        cascade(level);
+    }
+
+    // Everything left in this level 0 slot expires now
+    int32_t& head = heads[current & (SLOTS - 1)];
+    while (head != NO_NODE) {
+        u_int32_t key = static_cast<u_int32_t>(head);
+        unlink(key);
+        pending--;
+        expired.push_back(key);
+    }
+}
+
+// Lowest level whose span reaches the expiry, slot by the expiry's bits
+void TimerWheel::link(u_int32_t key) {
+    Node& node = nodes[key];
+    u_int64_t delta = node.expiry - current;
+    unsigned level = 0;
+    while (level + 1 < LEVELS && (delta >> (LEVEL_BITS * (level + 1))) != 0) {
+        level++;
+    }
+    size_t slot = level * SLOTS +
+        ((node.expiry >> (LEVEL_BITS * level)) & (SLOTS - 1));
+
+    node.slot = static_cast<int32_t>(slot);
+    node.prev = NO_NODE;
+    node.next = heads[slot];
+    if (node.next != NO_NODE) {
+        nodes[node.next].prev = static_cast<int32_t>(key);
+    }
+    heads[slot] = static_cast<int32_t>(key);
+}
+
+void TimerWheel::unlink(u_int32_t key) {
+    Node& node = nodes[key];
+    if (node.prev != NO_NODE) {
+        nodes[node.prev].next = node.next;
+    } else {
+        heads[node.slot] = node.next;
+    }
+    if (node.next != NO_NODE) {
+        nodes[node.next].prev = node.prev;
+    }
+    node.next = NO_NODE;
+    node.prev = NO_NODE;
+    node.slot = NO_NODE;
+}
+
+// Re-link every timer of the current slot of 'level' one level down (or
+// further, if it is due sooner)
+void TimerWheel::cascade(unsigned level) {
+    size_t slot = level * SLOTS +
+        ((current >> (LEVEL_BITS * level)) & (SLOTS - 1));
+    int32_t key = heads[slot];
+    heads[slot] = NO_NODE;
+    while (key != NO_NODE) {
+        int32_t next = nodes[key].next;
+        link(static_cast<u_int32_t>(key));
+        key = next;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <vector>
+#include <cstddef>
+#include <sys/types.h>
+
+/**
+ * @brief Hierarchical timer wheel over a dense key space [0, capacity)
+ *
+ * Level 0 has one slot per tick for the next SLOTS ticks; each level above
+ * covers SLOTS times the span of the one below. A timer goes to the lowest
+ * level that reaches its expiry and moves down a level (cascades) when
+ * the wheel below wraps around to it, so it is touched at most LEVELS
+ * times however long its delay.
+ *
+ * Slots are intrusive doubly linked lists threaded through one node per
+ * key: schedule() and cancel() are O(1), and tick() costs O(1) plus the
+ * timers it cascades or expires, whatever the number of timers pending.
+ */
+class TimerWheel {
+public:
+    static constexpr unsigned LEVEL_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << LEVEL_BITS;  // Per level
+    static constexpr unsigned LEVELS = 4;
+    static constexpr u_int64_t MAX_DELAY =                     // In ticks
+        (u_int64_t(1) << (LEVEL_BITS * LEVELS)) - 1;
+
+    explicit TimerWheel(size_t capacity);
+
+    // Arm 'key' to expire 'delay' ticks from now (at least 1, at most
+    // MAX_DELAY); re-arms it if already pending
+    void schedule(u_int32_t key, u_int64_t delay);
+    bool cancel(u_int32_t key);
+    bool isScheduled(u_int32_t key) const;
+
+    // Tick at which 'key' expires (or last expired)
+    u_int64_t getExpiry(u_int32_t key) const { return nodes[key].expiry; }
+    u_int64_t getCurrentTick() const { return current; }
+    size_t size() const { return pending; }
+    size_t getCapacity() const { return nodes.size(); }
+
+    // Advance one tick and append the keys expiring on it to 'expired'
+    void tick(std::vector<u_int32_t>& expired);
+
+private:
+    static constexpr int32_t NO_NODE = -1;
+
+    struct Node {
+        int32_t next;
+        int32_t prev;
+        int32_t slot;        // Index in 'heads', NO_NODE when not pending
+        u_int64_t expiry;
+    };
+
+    void link(u_int32_t key);
+    void unlink(u_int32_t key);
+    void cascade(unsigned level);
+
+    std::vector<Node> nodes;      // One per key
+    std::vector<int32_t> heads;   // LEVELS * SLOTS list heads
+    u_int64_t current;            // Last tick processed
+    size_t pending;
+};
+
+#endif // TIMERWHEEL_H
@@ -0,0 +1,108 @@
+#include "WorkerPool.h"
+
+using namespace std;
+
+WorkerPool::WorkerPool(unsigned threads)
+    : generation(0), busyWorkers(0), stopping(false), body(nullptr),
+      count(0), grain(1), next(0) {
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+    for (unsigned i = 1; i < threads; i++) {
+        workers.push_back(thread(&WorkerPool::run, this));
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        lock_guard<mutex> lock(stateMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void WorkerPool::parallelFor(size_t count, size_t grain, const Body& body) {
+    if (count == 0) {
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+
+    // Small loops are not worth waking anyone
+    if (workers.empty() || count <= grain) {
+        body(0, count);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(stateMutex);
+        this->body = &body;
+        this->count = count;
+        this->grain = grain;
+        next.store(0);
+        failure = nullptr;
+        busyWorkers = workers.size();
+        generation++;
+    }
+    wake.notify_all();
+
+    work(); // The caller takes chunks too
+
+    unique_lock<mutex> lock(stateMutex);
+    finished.wait(lock, [this]() { return busyWorkers == 0; });
+    this->body = nullptr;
+    if (failure) {
+        exception_ptr error = failure;
+        failure = nullptr;
+        rethrow_exception(error);
+    }
+}
+
+// Worker thread: one pass of work() per loop started
+void WorkerPool::run() {
+    u_int64_t seen = 0;
+    for (;;) {
+        {
+            unique_lock<mutex> lock(stateMutex);
+            wake.wait(lock, [this, seen]() {
+                return stopping || generation != seen;
+            });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        work();
+
+        lock_guard<mutex> lock(stateMutex);
+        if (--busyWorkers == 0) {
+            finished.notify_one();
+        }
+    }
+}
+
+// Take chunks until the range is exhausted; after a failure the remaining
+// chunks are skipped
+void WorkerPool::work() {
+    for (;;) {
+        size_t begin = next.fetch_add(grain);
+        if (begin >= count) {
+            return;
+        }
+        size_t end = (count - begin < grain) ? count : begin + grain;
+        try {
+            (*body)(begin, end);
+        } catch (...) {
+            lock_guard<mutex> lock(stateMutex);
+            if (!failure) {
+                failure = current_exception();
+            }
+            next.store(count);
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <cstddef>
+#include <sys/types.h>
+
+/**
+ * @brief Fixed set of threads that split loops over an index range
+ *
+ * parallelFor() hands out chunks of [0, count) from one atomic counter to
+ * the workers and to the calling thread, and returns once every chunk has
+ * run. Threads are started once, so a loop costs one wake-up per worker
+ * instead of a thread creation. One loop runs at a time: the pool is
+ * meant to be driven by a single owner thread.
+ *
+ * An exception thrown by the loop body is rethrown in the calling thread
+ * (the first one, once every chunk has finished).
+ */
+class WorkerPool {
+public:
+    typedef std::function<void(size_t begin, size_t end)> Body;
+
+    // 'threads' counts the calling thread; 0 = one per hardware thread
+    explicit WorkerPool(unsigned threads = 0);
+    ~WorkerPool(); // Joins the workers
+
+    // Non-copyable: owns threads
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Run body(begin, end) over [0, count) in chunks of up to 'grain'
+    void parallelFor(size_t count, size_t grain, const Body& body);
+
+    unsigned getThreadCount() const {
+        return static_cast<unsigned>(workers.size()) + 1;
+    }
+
+private:
+    void run();
+    void work();
+
+    std::mutex stateMutex;
+    std::condition_variable wake;      // New loop or stopping
+    std::condition_variable finished;  // Every worker left the loop
+    u_int64_t generation;              // Loops started so far
+    size_t busyWorkers;                // Workers still in the current loop
+    bool stopping;
+
+    // Current loop
+    const Body* body;
+    size_t count;
+    size_t grain;
+    std::atomic<size_t> next;          // First index not handed out yet
+    std::exception_ptr failure;
+
+    std::vector<std::thread> workers;  // Started last, joined first
+};
+
+#endif // WORKERPOOL_H